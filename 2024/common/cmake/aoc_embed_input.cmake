@@ -0,0 +1,53 @@
+# aoc_embed_input(<target> <day>)
+#
+# When AOC_EMBED_INPUT_DIR is set and holds <day>/input (same layout as the
+# repo), that file is baked into <target> as aoc::embedded_input through a
+# generated aoc/embedded_input.hpp and AOC_EMBEDDED_INPUT is defined, so the
+# solver can parse and precompute at compile time. Targets without an input
+# in that directory keep reading ./input at run time.
+
+include_guard(GLOBAL)
+
+function(aoc_embed_input target day)
+  if (NOT AOC_EMBED_INPUT_DIR)
+    return()
+  endif ()
+
+  set(input_file "${AOC_EMBED_INPUT_DIR}/${day}/input")
+  if (NOT EXISTS "${input_file}")
+    message(STATUS "${target}: ${input_file} not found, solving at run time")
+    return()
+  endif ()
+
+  # re-run the generation whenever the input changes
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${input_file}")
+
+  file(READ "${input_file}" input_hex HEX)
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "'\\\\x\\1'," input_bytes "${input_hex}")
+
+  set(embed_dir "${CMAKE_CURRENT_BINARY_DIR}/${target}_embed")
+  file(CONFIGURE OUTPUT "${embed_dir}/aoc/embedded_input.hpp" CONTENT [=[
+#pragma once
+
+#include <string_view>
+
+// generated by aoc_embed_input() from @input_file@
+namespace aoc {
+inline constexpr char embedded_input_data[] = {@input_bytes@ '\0'};
+inline constexpr std::string_view embedded_input{
+    embedded_input_data, sizeof(embedded_input_data) - 1};
+} // namespace aoc
+]=] @ONLY)
+
+  target_include_directories(${target} PRIVATE "${embed_dir}")
+  target_compile_definitions(${target} PRIVATE AOC_EMBEDDED_INPUT)
+
+  # the whole input gets walked inside the compiler, lift the default limits
+  if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    target_compile_options(${target} PRIVATE
+      -fconstexpr-loop-limit=16777216
+      -fconstexpr-ops-limit=4294967296)
+  elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    target_compile_options(${target} PRIVATE -fconstexpr-steps=1073741824)
+  endif ()
+endfunction()
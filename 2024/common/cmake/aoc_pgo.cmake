@@ -0,0 +1,115 @@
+# Release flags, link time optimisation and profile guided optimisation for
+# the day binaries. Release is kept at plain -O2 so it can serve as the
+# baseline the optimised builds get benchmarked against.
+#
+#   AOC_LTO=ON        link time optimisation (checked with check_ipo_supported)
+#   AOC_PGO=GENERATE  instrumented build, then `cmake --build . -t pgo-train`
+#                     runs every solver on generated inputs into AOC_PGO_DIR
+#   AOC_PGO=USE       rebuild with the profiles collected in AOC_PGO_DIR
+#
+# GCC names its profiles after the object files, so GENERATE and USE have to
+# happen in the same build tree; aoc_pgo_pipeline.cmake runs all the stages.
+# Include this after the tools and before the days: only targets created
+# afterwards get instrumented.
+
+include_guard(GLOBAL)
+
+if (NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+  set(CMAKE_BUILD_TYPE Release CACHE STRING "Build type" FORCE)
+endif ()
+string(REPLACE "-O3" "-O2" CMAKE_CXX_FLAGS_RELEASE "${CMAKE_CXX_FLAGS_RELEASE}")
+
+option(AOC_LTO "Build the day binaries with link time optimisation" OFF)
+set(AOC_PGO OFF CACHE STRING "Profile guided optimisation stage: OFF, GENERATE or USE")
+set_property(CACHE AOC_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(AOC_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH
+  "Where AOC_PGO=GENERATE writes profiles and AOC_PGO=USE reads them")
+set(AOC_BENCH_BASELINE "" CACHE PATH
+  "Build tree the bench target compares this one against, e.g. a plain Release build")
+
+if (AOC_LTO)
+  include(CheckIPOSupported)
+  check_ipo_supported(RESULT lto_supported OUTPUT lto_error LANGUAGES CXX)
+  if (NOT lto_supported)
+    message(FATAL_ERROR "AOC_LTO: ${lto_error}")
+  endif ()
+  set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+endif ()
+
+if (NOT CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang"
+    AND NOT AOC_PGO STREQUAL "OFF")
+  message(FATAL_ERROR "AOC_PGO needs GCC or Clang, not ${CMAKE_CXX_COMPILER_ID}")
+endif ()
+
+if (AOC_PGO STREQUAL "GENERATE")
+  file(MAKE_DIRECTORY "${AOC_PGO_DIR}")
+  if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    # day solvers may be multithreaded, keep the counters consistent
+    add_compile_options(-fprofile-generate=${AOC_PGO_DIR} -fprofile-update=atomic)
+  else ()
+    add_compile_options(-fprofile-generate=${AOC_PGO_DIR})
+  endif ()
+  add_link_options(-fprofile-generate=${AOC_PGO_DIR})
+elseif (AOC_PGO STREQUAL "USE")
+  if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    # code the training run never reached is still optimised normally
+    add_compile_options(-fprofile-use=${AOC_PGO_DIR} -fprofile-partial-training
+      -fprofile-correction -Wno-missing-profile)
+    add_link_options(-fprofile-use=${AOC_PGO_DIR})
+  else ()
+    add_compile_options(-fprofile-use=${AOC_PGO_DIR}/default.profdata
+      -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+    add_link_options(-fprofile-use=${AOC_PGO_DIR}/default.profdata)
+  endif ()
+elseif (NOT AOC_PGO STREQUAL "OFF")
+  message(FATAL_ERROR "AOC_PGO must be OFF, GENERATE or USE, got '${AOC_PGO}'")
+endif ()
+
+# aoc_add_tool_targets()
+#
+# Call once every day has been added. Defines
+#   pgo-train  runs each solver once on the training inputs (aoc_bench --train)
+#   bench      times each solver against AOC_BENCH_BASELINE, if set
+#   verify     checks each solver against its reference copy (aoc_verify)
+function(aoc_add_tool_targets)
+  set(solvers)
+  set(references)
+  foreach (day RANGE 1 25)
+    foreach (part 1 2)
+      if (TARGET day${day}_p${part})
+        list(APPEND solvers day${day}_p${part})
+      endif ()
+      if (TARGET day${day}_p${part}_reference)
+        list(APPEND references day${day}_p${part}_reference)
+      endif ()
+    endforeach ()
+  endforeach ()
+
+  set(merge_profiles)
+  if (AOC_PGO STREQUAL "GENERATE" AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    find_program(AOC_LLVM_PROFDATA NAMES llvm-profdata
+      HINTS "${CMAKE_CXX_COMPILER}/.." REQUIRED)
+    set(merge_profiles COMMAND "${CMAKE_COMMAND}"
+      -DPROFDATA=${AOC_LLVM_PROFDATA} -DPROFILE_DIR=${AOC_PGO_DIR}
+      -P "${CMAKE_CURRENT_FUNCTION_LIST_DIR}/aoc_pgo_merge.cmake")
+  endif ()
+
+  add_custom_target(pgo-train
+    COMMAND aoc_bench --train "${CMAKE_BINARY_DIR}"
+    ${merge_profiles}
+    COMMENT "Training the day binaries on generated inputs"
+    USES_TERMINAL VERBATIM)
+  add_dependencies(pgo-train aoc_bench ${solvers})
+
+  add_custom_target(bench
+    COMMAND aoc_bench "${CMAKE_BINARY_DIR}" ${AOC_BENCH_BASELINE}
+    COMMENT "Benchmarking the day binaries"
+    USES_TERMINAL VERBATIM)
+  add_dependencies(bench aoc_bench ${solvers})
+
+  add_custom_target(verify
+    COMMAND aoc_verify "${CMAKE_BINARY_DIR}"
+    COMMENT "Checking the day binaries against their references"
+    USES_TERMINAL VERBATIM)
+  add_dependencies(verify aoc_verify ${solvers} ${references})
+endfunction()
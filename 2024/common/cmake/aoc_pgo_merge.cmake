@@ -0,0 +1,10 @@
+# cmake -DPROFDATA=<llvm-profdata> -DPROFILE_DIR=<dir> -P aoc_pgo_merge.cmake
+#
+# Clang writes one .profraw per process, -fprofile-use wants them merged
+file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+if (NOT raw_profiles)
+  message(FATAL_ERROR "no .profraw files in ${PROFILE_DIR}, did pgo-train run?")
+endif ()
+execute_process(
+  COMMAND "${PROFDATA}" merge -output=${PROFILE_DIR}/default.profdata ${raw_profiles}
+  COMMAND_ERROR_IS_FATAL ANY)
@@ -0,0 +1,51 @@
+# cmake [-DBUILD_ROOT=<dir>] [-DGENERATOR=<generator>] -P aoc_pgo_pipeline.cmake
+#
+# Full release pipeline, from the 2024 directory:
+#   1. <root>/baseline  plain -O2 Release build
+#   2. <root>/pgo       instrumented build (AOC_PGO=GENERATE) + pgo-train
+#   3. <root>/pgo       reconfigured with AOC_PGO=USE and AOC_LTO=ON, rebuilt
+#   4. aoc_bench of <root>/pgo against <root>/baseline, speedup per day
+# BUILD_ROOT defaults to build-pgo next to the sources.
+
+get_filename_component(source_dir "${CMAKE_CURRENT_LIST_DIR}/../.." ABSOLUTE)
+if (NOT BUILD_ROOT)
+  set(BUILD_ROOT "${source_dir}/build-pgo")
+endif ()
+set(generator_args)
+if (GENERATOR)
+  set(generator_args -G "${GENERATOR}")
+endif ()
+
+set(baseline_dir "${BUILD_ROOT}/baseline")
+set(pgo_dir "${BUILD_ROOT}/pgo")
+
+function(run_step description)
+  message(STATUS "${description}")
+  execute_process(COMMAND ${ARGN} COMMAND_ERROR_IS_FATAL ANY)
+endfunction()
+
+run_step("configuring the -O2 baseline"
+  "${CMAKE_COMMAND}" -S "${source_dir}" -B "${baseline_dir}" ${generator_args}
+  -DCMAKE_BUILD_TYPE=Release -DAOC_PGO=OFF -DAOC_LTO=OFF)
+run_step("building the -O2 baseline"
+  "${CMAKE_COMMAND}" --build "${baseline_dir}" --parallel)
+
+# stale profiles from an older tree would only produce mismatch warnings
+file(REMOVE_RECURSE "${pgo_dir}/pgo-profiles")
+run_step("configuring the instrumented build"
+  "${CMAKE_COMMAND}" -S "${source_dir}" -B "${pgo_dir}" ${generator_args}
+  -DCMAKE_BUILD_TYPE=Release -DAOC_PGO=GENERATE -DAOC_LTO=OFF
+  "-DAOC_PGO_DIR=${pgo_dir}/pgo-profiles")
+run_step("building the instrumented binaries"
+  "${CMAKE_COMMAND}" --build "${pgo_dir}" --parallel)
+run_step("training"
+  "${CMAKE_COMMAND}" --build "${pgo_dir}" --target pgo-train)
+
+run_step("configuring the PGO + LTO build"
+  "${CMAKE_COMMAND}" -S "${source_dir}" -B "${pgo_dir}"
+  -DAOC_PGO=USE -DAOC_LTO=ON "-DAOC_BENCH_BASELINE=${baseline_dir}")
+run_step("building the PGO + LTO binaries"
+  "${CMAKE_COMMAND}" --build "${pgo_dir}" --parallel)
+
+run_step("benchmarking against the -O2 baseline"
+  "${CMAKE_COMMAND}" --build "${pgo_dir}" --target bench)
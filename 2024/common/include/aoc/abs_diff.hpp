@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "aoc/cpu.hpp"
+#include "aoc/parallel.hpp"
+
+#if AOC_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// sum of |a[i] - b[i]| over two int arrays into a 64 bit total, e.g. day 1's
+// sorted columns. max(a, b) - min(a, b) is exact as an unsigned 32 bit value
+// for any pair of ints, the vector paths then widen the lanes to 64 bits by
+// splitting even and odd lanes instead of shuffling.
+namespace aoc::kernels {
+
+using SumAbsDiffFn = std::uint64_t(const int *, const int *, std::size_t);
+
+namespace detail {
+
+inline std::uint64_t sum_abs_diff_scalar(const int *a, const int *b,
+                                         std::size_t n) {
+  std::uint64_t sum = 0;
+  for (auto i = 0UL; i < n; ++i) {
+    const auto x = static_cast<std::uint32_t>(a[i]);
+    const auto y = static_cast<std::uint32_t>(b[i]);
+    sum += a[i] > b[i] ? x - y : y - x;
+  }
+  return sum;
+}
+
+#if AOC_X86_DISPATCH
+AOC_TARGET_SSE42 inline std::uint64_t
+sum_abs_diff_sse42(const int *a, const int *b, std::size_t n) {
+  const auto low = _mm_set1_epi64x(0xffffffff);
+  auto acc = _mm_setzero_si128();
+  auto i = 0UL;
+  for (; i + 4 <= n; i += 4) {
+    const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    const auto y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    const auto d = _mm_sub_epi32(_mm_max_epi32(x, y), _mm_min_epi32(x, y));
+    acc = _mm_add_epi64(acc, _mm_and_si128(d, low));
+    acc = _mm_add_epi64(acc, _mm_srli_epi64(d, 32));
+  }
+  const auto sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(acc)) +
+                   static_cast<std::uint64_t>(_mm_extract_epi64(acc, 1));
+  return sum + sum_abs_diff_scalar(a + i, b + i, n - i);
+}
+
+AOC_TARGET_AVX2 inline std::uint64_t
+sum_abs_diff_avx2(const int *a, const int *b, std::size_t n) {
+  const auto low = _mm256_set1_epi64x(0xffffffff);
+  auto acc = _mm256_setzero_si256();
+  auto i = 0UL;
+  for (; i + 8 <= n; i += 8) {
+    const auto x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    const auto y =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    const auto d =
+        _mm256_sub_epi32(_mm256_max_epi32(x, y), _mm256_min_epi32(x, y));
+    acc = _mm256_add_epi64(acc, _mm256_and_si256(d, low));
+    acc = _mm256_add_epi64(acc, _mm256_srli_epi64(d, 32));
+  }
+  const auto half = _mm_add_epi64(_mm256_castsi256_si128(acc),
+                                  _mm256_extracti128_si256(acc, 1));
+  const auto sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(half)) +
+                   static_cast<std::uint64_t>(_mm_extract_epi64(half, 1));
+  return sum + sum_abs_diff_scalar(a + i, b + i, n - i);
+}
+
+AOC_TARGET_AVX512BW inline std::uint64_t
+sum_abs_diff_avx512bw(const int *a, const int *b, std::size_t n) {
+  const auto low = _mm512_set1_epi64(0xffffffff);
+  auto acc = _mm512_setzero_si512();
+  auto i = 0UL;
+  for (; i + 16 <= n; i += 16) {
+    const auto x = _mm512_loadu_si512(a + i);
+    const auto y = _mm512_loadu_si512(b + i);
+    const auto d =
+        _mm512_sub_epi32(_mm512_max_epi32(x, y), _mm512_min_epi32(x, y));
+    acc = _mm512_add_epi64(acc, _mm512_and_si512(d, low));
+    acc = _mm512_add_epi64(acc, _mm512_srli_epi64(d, 32));
+  }
+  const auto sum = static_cast<std::uint64_t>(_mm512_reduce_add_epi64(acc));
+  return sum + sum_abs_diff_scalar(a + i, b + i, n - i);
+}
+#endif
+
+} // namespace detail
+
+#if AOC_X86_DISPATCH
+inline constexpr cpu::Kernel<SumAbsDiffFn> sum_abs_diff_kernel{
+    detail::sum_abs_diff_scalar, detail::sum_abs_diff_sse42,
+    detail::sum_abs_diff_avx2, detail::sum_abs_diff_avx512bw};
+#else
+inline constexpr cpu::Kernel<SumAbsDiffFn> sum_abs_diff_kernel{
+    detail::sum_abs_diff_scalar};
+#endif
+
+// pairs up to the shorter of the two
+inline std::uint64_t sum_abs_diff(std::span<const int> a,
+                                  std::span<const int> b) {
+  return sum_abs_diff_kernel.bind()(a.data(), b.data(),
+                                    std::min(a.size(), b.size()));
+}
+
+// same, each thread reduces one chunk and the partial sums are added up
+inline std::uint64_t
+parallel_sum_abs_diff(std::span<const int> a, std::span<const int> b,
+                      std::size_t threads = par::hardware_threads()) {
+  const auto n = std::min(a.size(), b.size());
+  const auto chunks = par::chunk_count(n, 1 << 18, threads);
+  auto *kernel = sum_abs_diff_kernel.bind();
+
+  std::vector<std::uint64_t> partial(chunks);
+  par::for_each_chunk(n, chunks, [&](auto i, par::Range range) {
+    partial[i] =
+        kernel(a.data() + range.begin, b.data() + range.begin, range.size());
+  });
+
+  std::uint64_t sum = 0;
+  for (const auto k : partial) {
+    sum += k;
+  }
+  return sum;
+}
+
+} // namespace aoc::kernels
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+// multi-word search in one pass over the text: the trie of the words with
+// every missing edge filled in from the failure links, so each byte is one
+// table lookup whatever the number of words. bytes that appear in no word
+// share one column of the table, which keeps it small for letter grids.
+class AhoCorasick {
+public:
+  using State = std::uint32_t;
+
+  explicit AhoCorasick(std::span<const std::string_view> words_)
+      : word_lengths(words_.size()) {
+    for (const auto word : words_) {
+      for (const auto c : word) {
+        auto &k = classes[static_cast<unsigned char>(c)];
+        if (k == 0) {
+          k = static_cast<std::uint16_t>(++alphabet);
+        }
+      }
+    }
+    ++alphabet;
+
+    // the trie, 0 is the root and missing edges are 0 for now
+    add_state();
+    std::vector<std::vector<std::uint32_t>> ends(1);
+    for (auto w = 0UL; w < words_.size(); ++w) {
+      State state = 0;
+      for (const auto c : words_[w]) {
+        const auto edge = state * alphabet + class_of(c);
+        if (goto_[edge] == 0) {
+          // add_state() may move the table, so no reference into it here
+          const auto child = add_state();
+          goto_[edge] = child;
+          ends.emplace_back();
+        }
+        state = goto_[edge];
+      }
+      // the empty word is never reported
+      if (!words_[w].empty()) {
+        ends[state].push_back(static_cast<std::uint32_t>(w));
+      }
+      word_lengths[w] = words_[w].size();
+    }
+
+    // breadth first, so a state's failure link is complete before it is
+    // used; a state reports its own words and then its failure link's
+    std::vector<State> fail(states(), 0);
+    std::vector<State> order{0};
+    for (auto i = 0UL; i < order.size(); ++i) {
+      const auto state = order[i];
+      for (auto k = 0UL; k < alphabet; ++k) {
+        auto &edge = goto_[state * alphabet + k];
+        if (edge != 0 && !(state == 0 && k == 0)) {
+          fail[edge] = state == 0 ? 0 : goto_[fail[state] * alphabet + k];
+          order.push_back(edge);
+        } else {
+          edge = state == 0 ? 0 : goto_[fail[state] * alphabet + k];
+        }
+      }
+    }
+
+    std::vector<std::vector<std::uint32_t>> reports(states());
+    for (const auto state : order) {
+      reports[state] = ends[state];
+      if (state != 0) {
+        const auto &inherited = reports[fail[state]];
+        reports[state].insert(reports[state].end(), inherited.begin(),
+                              inherited.end());
+      }
+    }
+    output_begin.reserve(states() + 1);
+    for (const auto &k : reports) {
+      output_begin.push_back(static_cast<std::uint32_t>(outputs.size()));
+      outputs.insert(outputs.end(), k.begin(), k.end());
+    }
+    output_begin.push_back(static_cast<std::uint32_t>(outputs.size()));
+  }
+
+  std::size_t size() const { return word_lengths.size(); }
+  std::size_t states() const { return goto_.size() / alphabet; }
+  std::size_t length(std::size_t word) const { return word_lengths[word]; }
+
+  State next(State state, char c) const {
+    return goto_[state * alphabet + class_of(c)];
+  }
+
+  // the words that end right after the byte that led to `state`
+  std::span<const std::uint32_t> matches(State state) const {
+    return std::span<const std::uint32_t>(outputs).subspan(
+        output_begin[state], output_begin[state + 1] - output_begin[state]);
+  }
+
+  // visit(word, end) for every occurrence, text[end - length(word), end).
+  // next() and matches() do the same one byte at a time, for running many
+  // texts side by side (e.g. all the columns of a grid, read row by row)
+  template <typename Visitor>
+  void scan(std::string_view text, Visitor &&visit) const {
+    State state = 0;
+    for (auto i = 0UL; i < text.size(); ++i) {
+      state = next(state, text[i]);
+      for (const auto word : matches(state)) {
+        visit(static_cast<std::size_t>(word), i + 1);
+      }
+    }
+  }
+
+private:
+  std::size_t class_of(char c) const {
+    return classes[static_cast<unsigned char>(c)];
+  }
+
+  State add_state() {
+    goto_.resize(goto_.size() + alphabet, 0);
+    return static_cast<State>(goto_.size() / alphabet - 1);
+  }
+
+  std::array<std::uint16_t, 256> classes{};
+  std::size_t alphabet = 0;
+  std::vector<State> goto_{};
+  std::vector<std::uint32_t> output_begin{};
+  std::vector<std::uint32_t> outputs{};
+  std::vector<std::size_t> word_lengths;
+};
+
+} // namespace aoc
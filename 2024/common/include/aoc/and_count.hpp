@@ -0,0 +1,141 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "aoc/cpu.hpp"
+
+#if AOC_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// the inner loop of a search on bit planes: AND a few rows of BitGrid words
+// together, each read at its own bit offset, and count the bits left. the
+// vector paths do 4 (AVX2) or 8 (AVX-512) words at once with variable
+// shifts, a shift by 64 giving 0 so offsets that are whole words need no
+// branch, and count bits with the nibble lookup table of Mula et al.
+namespace aoc::kernels {
+
+// sum over w in [first, last) of popcount(AND over k < count of
+//   (rows[k][w] >> shifts[k]) | (rows[k][w + 1] << (64 - shifts[k])))
+// where a shift by 64 gives 0 and shifts[k] < 64; rows[k][last] is read
+using AndCountFn = std::size_t(const std::uint64_t *const *, const unsigned *,
+                               std::size_t, std::size_t, std::size_t);
+
+namespace detail {
+
+inline std::size_t and_count_scalar(const std::uint64_t *const *rows,
+                                    const unsigned *shifts, std::size_t count,
+                                    std::size_t first, std::size_t last) {
+  std::size_t total = 0;
+  for (auto w = first; w < last; ++w) {
+    auto found = ~std::uint64_t{0};
+    for (auto k = 0UL; k < count; ++k) {
+      // two steps, so a shift of 0 moves the next word out entirely
+      found &= (rows[k][w] >> shifts[k]) |
+               ((rows[k][w + 1] << 1) << (63 - shifts[k]));
+    }
+    total += static_cast<std::size_t>(std::popcount(found));
+  }
+  return total;
+}
+
+#if AOC_X86_DISPATCH
+// the scalar loop with popcnt instead of the bit twiddling fallback
+AOC_TARGET_SSE42 inline std::size_t
+and_count_sse42(const std::uint64_t *const *rows, const unsigned *shifts,
+                std::size_t count, std::size_t first, std::size_t last) {
+  std::size_t total = 0;
+  for (auto w = first; w < last; ++w) {
+    auto found = ~std::uint64_t{0};
+    for (auto k = 0UL; k < count; ++k) {
+      found &= (rows[k][w] >> shifts[k]) |
+               ((rows[k][w + 1] << 1) << (63 - shifts[k]));
+    }
+    total += static_cast<std::size_t>(_mm_popcnt_u64(found));
+  }
+  return total;
+}
+
+AOC_TARGET_AVX2 inline std::size_t
+and_count_avx2(const std::uint64_t *const *rows, const unsigned *shifts,
+               std::size_t count, std::size_t first, std::size_t last) {
+  const auto nibbles = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2,
+                                        3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+                                        2, 3, 2, 3, 3, 4);
+  const auto low = _mm256_set1_epi8(0x0f);
+  auto sums = _mm256_setzero_si256();
+  auto w = first;
+  for (; w + 4 <= last; w += 4) {
+    auto found = _mm256_set1_epi64x(-1);
+    for (auto k = 0UL; k < count; ++k) {
+      const auto here = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(rows[k] + w));
+      const auto next = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(rows[k] + w + 1));
+      const auto right = _mm256_set1_epi64x(shifts[k]);
+      const auto left = _mm256_set1_epi64x(64 - shifts[k]);
+      found = _mm256_and_si256(
+          found, _mm256_or_si256(_mm256_srlv_epi64(here, right),
+                                 _mm256_sllv_epi64(next, left)));
+    }
+    const auto bits = _mm256_add_epi8(
+        _mm256_shuffle_epi8(nibbles, _mm256_and_si256(found, low)),
+        _mm256_shuffle_epi8(nibbles,
+                            _mm256_and_si256(_mm256_srli_epi16(found, 4),
+                                             low)));
+    sums = _mm256_add_epi64(sums,
+                            _mm256_sad_epu8(bits, _mm256_setzero_si256()));
+  }
+  const auto half = _mm_add_epi64(_mm256_castsi256_si128(sums),
+                                  _mm256_extracti128_si256(sums, 1));
+  const auto total = static_cast<std::size_t>(_mm_cvtsi128_si64(half)) +
+                     static_cast<std::size_t>(_mm_extract_epi64(half, 1));
+  return total + and_count_scalar(rows, shifts, count, w, last);
+}
+
+AOC_TARGET_AVX512BW inline std::size_t
+and_count_avx512bw(const std::uint64_t *const *rows, const unsigned *shifts,
+                   std::size_t count, std::size_t first, std::size_t last) {
+  const auto nibbles = _mm512_broadcast_i32x4(
+      _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+  const auto low = _mm512_set1_epi8(0x0f);
+  auto sums = _mm512_setzero_si512();
+  auto w = first;
+  for (; w + 8 <= last; w += 8) {
+    auto found = _mm512_set1_epi64(-1);
+    for (auto k = 0UL; k < count; ++k) {
+      const auto here = _mm512_loadu_si512(rows[k] + w);
+      const auto next = _mm512_loadu_si512(rows[k] + w + 1);
+      const auto right = _mm512_set1_epi64(shifts[k]);
+      const auto left = _mm512_set1_epi64(64 - shifts[k]);
+      found = _mm512_and_si512(
+          found, _mm512_or_si512(_mm512_srlv_epi64(here, right),
+                                 _mm512_sllv_epi64(next, left)));
+    }
+    const auto bits = _mm512_add_epi8(
+        _mm512_shuffle_epi8(nibbles, _mm512_and_si512(found, low)),
+        _mm512_shuffle_epi8(nibbles,
+                            _mm512_and_si512(_mm512_srli_epi16(found, 4),
+                                             low)));
+    sums = _mm512_add_epi64(sums,
+                            _mm512_sad_epu8(bits, _mm512_setzero_si512()));
+  }
+  const auto total = static_cast<std::size_t>(_mm512_reduce_add_epi64(sums));
+  return total + and_count_scalar(rows, shifts, count, w, last);
+}
+#endif
+
+} // namespace detail
+
+#if AOC_X86_DISPATCH
+inline constexpr cpu::Kernel<AndCountFn> and_count_kernel{
+    detail::and_count_scalar, detail::and_count_sse42,
+    detail::and_count_avx2, detail::and_count_avx512bw};
+#else
+inline constexpr cpu::Kernel<AndCountFn> and_count_kernel{
+    detail::and_count_scalar};
+#endif
+
+} // namespace aoc::kernels
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "aoc/equal_mask.hpp"
+#include "aoc/grid.hpp"
+#include "aoc/parallel.hpp"
+
+namespace aoc {
+
+// one bit per cell, rows padded to whole 64 bit words with the padding kept
+// clear. word(r, c) reads the 64 cells from column c on at any offset, zero
+// outside the grid, so "the cell dr rows down and dc columns right is set"
+// for 64 cells at once is a single call and combining planes is plain ANDs.
+class BitGrid {
+public:
+  BitGrid() = default;
+  BitGrid(std::size_t rows_, std::size_t cols_)
+      : row_count(rows_), col_count(cols_), stride((cols_ + 63) / 64),
+        bits(rows_ * stride) {}
+
+  // the cells of `grid` that satisfy pred(value)
+  template <typename T, typename Pred>
+  static BitGrid from(const Grid<T> &grid, Pred pred) {
+    BitGrid plane(grid.rows(), grid.cols());
+    for (auto r = 0UL; r < grid.rows(); ++r) {
+      const auto row = grid.row(r);
+      auto *out = plane.bits.data() + r * plane.stride;
+      for (auto w = 0UL; w < plane.stride; ++w) {
+        const auto cells = row.subspan(w * 64, std::min<std::size_t>(
+                                                   64, row.size() - w * 64));
+        // built in a register, one store per word
+        std::uint64_t word_ = 0;
+        for (auto k = 0UL; k < cells.size(); ++k) {
+          word_ |= std::uint64_t{pred(cells[k]) ? 1U : 0U} << k;
+        }
+        out[w] = word_;
+      }
+    }
+    return plane;
+  }
+
+  // the cells of a char grid equal to `value`
+  static BitGrid equal(const Grid<char> &grid, char value) {
+    return std::move(equal(grid, std::string_view(&value, 1), 1)[0]);
+  }
+
+  // one plane per char of `values`, in that order, from a single pass over
+  // the grid through kernels::equal_masks; rows are split between the
+  // threads
+  static std::vector<BitGrid>
+  equal(const Grid<char> &grid, std::string_view values,
+        std::size_t threads = par::hardware_threads()) {
+    std::vector<BitGrid> planes{};
+    planes.reserve(values.size());
+    for (auto v = 0UL; v < values.size(); ++v) {
+      planes.emplace_back(grid.rows(), grid.cols());
+    }
+    auto *kernel = kernels::equal_masks_kernel.bind();
+
+    const auto chunks = par::chunk_count(grid.rows(), 64, threads);
+    par::for_each_chunk(grid.rows(), chunks, [&](auto, par::Range range) {
+      std::vector<std::uint64_t *> out(values.size());
+      for (auto r = range.begin; r < range.end; ++r) {
+        for (auto v = 0UL; v < planes.size(); ++v) {
+          out[v] = planes[v].row(r);
+        }
+        kernel(grid.row(r).data(), grid.cols(), values.data(), values.size(),
+               out.data());
+      }
+    });
+    return planes;
+  }
+
+  std::size_t rows() const { return row_count; }
+  std::size_t cols() const { return col_count; }
+  // words per row
+  std::size_t words() const { return stride; }
+
+  void set(std::size_t r, std::size_t c) {
+    bits[r * stride + c / 64] |= std::uint64_t{1} << (c % 64);
+  }
+  bool test(std::size_t r, std::size_t c) const {
+    return (bits[r * stride + c / 64] >> (c % 64)) & 1U;
+  }
+
+  std::uint64_t *row(std::size_t r) { return bits.data() + r * stride; }
+  const std::uint64_t *row(std::size_t r) const {
+    return bits.data() + r * stride;
+  }
+
+  // bit i is cell (r, c + i), off-grid cells read as clear
+  std::uint64_t word(std::ptrdiff_t r, std::ptrdiff_t c) const {
+    if (r < 0 || static_cast<std::size_t>(r) >= row_count) {
+      return 0;
+    }
+    const auto *words_ = row(static_cast<std::size_t>(r));
+    // floor division, c may be negative
+    const auto q = c >= 0 ? c / 64 : -((-c + 63) / 64);
+    const auto s = static_cast<unsigned>(c - q * 64);
+    const auto at = [&](std::ptrdiff_t i) -> std::uint64_t {
+      return i >= 0 && static_cast<std::size_t>(i) < stride ? words_[i] : 0;
+    };
+    // both words inside the row is the common case
+    if (q >= 0 && static_cast<std::size_t>(q) + 1 < stride) {
+      return shifted(words_, static_cast<std::size_t>(c));
+    }
+    if (s == 0) {
+      return at(q);
+    }
+    return (at(q) >> s) | (at(q + 1) << (64 - s));
+  }
+
+  // word() on a row pointer with no checks at all, for loops that keep to
+  // the inside of the grid: words c / 64 and c / 64 + 1 must both be in the
+  // row
+  static std::uint64_t shifted(const std::uint64_t *words_, std::size_t c) {
+    const auto q = c / 64;
+    const auto s = static_cast<unsigned>(c % 64);
+    return s == 0 ? words_[q] : (words_[q] >> s) | (words_[q + 1] << (64 - s));
+  }
+
+  std::size_t count() const {
+    std::size_t total = 0;
+    for (const auto k : bits) {
+      total += static_cast<std::size_t>(std::popcount(k));
+    }
+    return total;
+  }
+
+private:
+  std::size_t row_count = 0;
+  std::size_t col_count = 0;
+  std::size_t stride = 0;
+  std::vector<std::uint64_t> bits{};
+};
+
+} // namespace aoc
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// runtime ISA dispatch: kernels are compiled for several instruction sets in
+// the same binary (through AOC_TARGET) and the best one the CPU supports is
+// picked at run time. the scalar version is mandatory and is what every other
+// path gets checked against, see `--force-isa=`.
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define AOC_X86_DISPATCH 1
+#define AOC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define AOC_X86_DISPATCH 0
+#define AOC_TARGET(isa)
+#endif
+
+#define AOC_TARGET_SSE42 AOC_TARGET("sse4.2,popcnt")
+#define AOC_TARGET_AVX2 AOC_TARGET("avx2,bmi,bmi2,popcnt")
+#define AOC_TARGET_AVX512BW                                                    \
+  AOC_TARGET("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")
+
+namespace aoc::cpu {
+
+enum class Isa : unsigned {
+  Scalar = 0,
+  Sse42,
+  Avx2,
+  Avx512bw,
+};
+
+inline constexpr std::size_t isa_count = 4;
+
+constexpr std::string_view to_string(Isa isa) {
+  switch (isa) {
+  case Isa::Scalar:
+    return "scalar";
+  case Isa::Sse42:
+    return "sse4.2";
+  case Isa::Avx2:
+    return "avx2";
+  case Isa::Avx512bw:
+    return "avx512bw";
+  }
+  return "unknown";
+}
+
+constexpr std::optional<Isa> parse_isa(std::string_view name) {
+  for (auto i = 0U; i < isa_count; ++i) {
+    if (to_string(static_cast<Isa>(i)) == name) {
+      return static_cast<Isa>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+struct Features {
+  bool sse42 = false;
+  bool avx2 = false;
+  bool avx512bw = false;
+  bool bmi2 = false;
+};
+
+inline Features detect() {
+  Features features{};
+#if AOC_X86_DISPATCH
+  __builtin_cpu_init();
+  features.sse42 = __builtin_cpu_supports("sse4.2");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.avx512bw = __builtin_cpu_supports("avx512f") &&
+                      __builtin_cpu_supports("avx512bw") &&
+                      __builtin_cpu_supports("avx512vl");
+  features.bmi2 = __builtin_cpu_supports("bmi2");
+#endif
+  return features;
+}
+
+// probed once, the first time anyone asks
+inline const Features &features() {
+  static const Features detected = detect();
+  return detected;
+}
+
+inline bool supports(Isa isa) {
+  const auto &f = features();
+  switch (isa) {
+  case Isa::Scalar:
+    return true;
+  case Isa::Sse42:
+    return f.sse42;
+  case Isa::Avx2:
+    // every avx2 kernel is also allowed to use bmi1/bmi2
+    return f.avx2 && f.bmi2;
+  case Isa::Avx512bw:
+    return f.avx512bw && f.bmi2;
+  }
+  return false;
+}
+
+inline Isa best_supported() {
+  for (auto i = isa_count; i-- > 0;) {
+    if (supports(static_cast<Isa>(i))) {
+      return static_cast<Isa>(i);
+    }
+  }
+  return Isa::Scalar;
+}
+
+namespace detail {
+inline std::atomic<Isa> &active() {
+  static std::atomic<Isa> isa{best_supported()};
+  return isa;
+}
+} // namespace detail
+
+inline Isa active_isa() {
+  return detail::active().load(std::memory_order_relaxed);
+}
+
+// caps every kernel at `isa`, so benchmarks can compare paths on one machine
+inline void force_isa(Isa isa) {
+  if (!supports(isa)) {
+    throw std::runtime_error("cpu does not support " +
+                             std::string(to_string(isa)));
+  }
+  detail::active().store(isa, std::memory_order_relaxed);
+}
+
+// honours AOC_FORCE_ISA from the environment and then `--force-isa=<isa>`
+// from the command line; other arguments are left for the caller
+inline void init(int argc, char **argv) {
+  const auto apply = [](std::string_view name) {
+    const auto isa = parse_isa(name);
+    if (!isa.has_value()) {
+      throw std::invalid_argument("unknown isa '" + std::string(name) +
+                                  "', expected scalar, sse4.2, avx2 or "
+                                  "avx512bw");
+    }
+    force_isa(*isa);
+  };
+
+  if (const auto *env = std::getenv("AOC_FORCE_ISA");
+      env != nullptr && *env != '\0') {
+    apply(env);
+  }
+
+  constexpr auto flag = std::string_view("--force-isa=");
+  for (auto i = 1; i < argc; ++i) {
+    const auto arg = std::string_view(argv[i]);
+    if (arg.starts_with(flag)) {
+      apply(arg.substr(flag.size()));
+    }
+  }
+}
+
+// one entry per ISA, nullptr where a kernel has no specialised version;
+// bind() picks the highest entry that is both implemented and allowed. there
+// is no call operator on purpose: the search is cheap but not free, so
+// callers bind once and keep the pointer
+template <typename Fn> class Kernel {
+public:
+  constexpr Kernel(Fn *scalar, Fn *sse42, Fn *avx2, Fn *avx512bw)
+      : impls{scalar, sse42, avx2, avx512bw} {}
+  constexpr explicit Kernel(Fn *scalar)
+      : Kernel(scalar, nullptr, nullptr, nullptr) {}
+
+  // resolve once and keep the pointer around for hot loops
+  Fn *bind(Isa isa = active_isa()) const {
+    for (auto i = static_cast<std::size_t>(isa) + 1; i-- > 0;) {
+      if (impls[i] != nullptr && supports(static_cast<Isa>(i))) {
+        return impls[i];
+      }
+    }
+    return impls[0];
+  }
+
+  // the ISA bind() would pick, handy for logging which path ran
+  Isa resolved_isa(Isa isa = active_isa()) const {
+    for (auto i = static_cast<std::size_t>(isa) + 1; i-- > 0;) {
+      if (impls[i] != nullptr && supports(static_cast<Isa>(i))) {
+        return static_cast<Isa>(i);
+      }
+    }
+    return Isa::Scalar;
+  }
+
+  // visits every variant this machine can run, scalar first, so callers can
+  // check the vector paths against it on the same input (aoc_verify does)
+  template <typename Visitor> void for_each_variant(Visitor visit) const {
+    for (auto i = 0UL; i < isa_count; ++i) {
+      if (impls[i] != nullptr && supports(static_cast<Isa>(i))) {
+        visit(static_cast<Isa>(i), impls[i]);
+      }
+    }
+  }
+
+private:
+  std::array<Fn *, isa_count> impls;
+};
+
+} // namespace aoc::cpu
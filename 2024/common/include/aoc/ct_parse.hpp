@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+// constexpr parsing helpers for inputs baked in with AOC_EMBED_INPUT_DIR,
+// everything here works on string_views so it can run inside the compiler
+namespace aoc::ct {
+
+constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+// pops the next line (without its '\n') off the front of `text`
+constexpr std::string_view next_line(std::string_view &text) {
+  const auto end = text.find('\n');
+  const auto line = text.substr(0, end);
+  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+  if (!line.empty() && line.back() == '\r') {
+    return line.substr(0, line.size() - 1);
+  }
+  return line;
+}
+
+// number of non-empty lines
+constexpr std::size_t count_lines(std::string_view text) {
+  std::size_t count = 0;
+  while (!text.empty()) {
+    if (!next_line(text).empty()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// number of unsigned integers anywhere in `text`
+constexpr std::size_t count_numbers(std::string_view text) {
+  std::size_t count = 0;
+  for (auto i = 0UL; i < text.size(); ++i) {
+    if (is_digit(text[i]) && (i == 0 || !is_digit(text[i - 1]))) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// skips to the next run of digits in `text` and consumes it
+template <typename T = unsigned long>
+constexpr T parse_uint(std::string_view &text) {
+  auto i = 0UL;
+  while (i < text.size() && !is_digit(text[i])) {
+    ++i;
+  }
+  T value{};
+  for (; i < text.size() && is_digit(text[i]); ++i) {
+    value = static_cast<T>(value * 10 + static_cast<T>(text[i] - '0'));
+  }
+  text.remove_prefix(i);
+  return value;
+}
+
+// largest unsigned integer anywhere in `text`
+template <typename T = unsigned long>
+constexpr T max_number(std::string_view text) {
+  T max{};
+  while (!text.empty()) {
+    const auto value = parse_uint<T>(text);
+    max = value > max ? value : max;
+  }
+  return max;
+}
+
+// splits at the first blank line, e.g. day5's rules and updates
+constexpr std::pair<std::string_view, std::string_view>
+split_sections(std::string_view text) {
+  auto rest = text;
+  while (!rest.empty()) {
+    const auto start = text.size() - rest.size();
+    if (next_line(rest).empty()) {
+      return {text.substr(0, start), rest};
+    }
+  }
+  return {text, {}};
+}
+
+} // namespace aoc::ct
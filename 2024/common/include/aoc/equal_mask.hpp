@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "aoc/cpu.hpp"
+
+#if AOC_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// the row loop of BitGrid::equal: which bytes of a row equal each of a few
+// values, 64 bytes to a word. every block of bytes is loaded once and
+// compared with all the values, so building the planes of a whole word
+// costs one pass over the grid. the vector paths get a 16, 32 or 64 bit
+// mask per compare; the scalar one uses the zero byte trick 8 bytes at a
+// time.
+namespace aoc::kernels {
+
+// bit i % 64 of out[v][i / 64] is cells[i] == values[v], for i < n; every
+// word up to (n + 63) / 64 is overwritten, bits past n come out clear
+using EqualMasksFn = void(const char *, std::size_t, const char *,
+                          std::size_t, std::uint64_t *const *);
+
+namespace detail {
+
+// bit k set when byte k of x is zero
+inline std::uint64_t zero_bytes(std::uint64_t x) {
+  constexpr auto low7 = std::uint64_t{0x7f7f7f7f7f7f7f7f};
+  constexpr auto gather = std::uint64_t{0x0102040810204080};
+  const auto zero = ~(((x & low7) + low7) | x | low7);
+  return ((zero >> 7) * gather) >> 56;
+}
+
+// the words from `first` on, which is where the vector paths hand over
+inline void equal_masks_from(const char *cells, std::size_t n,
+                             const char *values, std::size_t count,
+                             std::uint64_t *const *out, std::size_t first) {
+  const auto words = (n + 63) / 64;
+  for (auto w = first; w < words; ++w) {
+    const auto *block = cells + w * 64;
+    const auto size = n - w * 64 < 64 ? n - w * 64 : 64;
+    for (auto v = 0UL; v < count; ++v) {
+      const auto pattern = std::uint64_t{0x0101010101010101} *
+                           static_cast<unsigned char>(values[v]);
+      std::uint64_t word = 0;
+      auto k = 0UL;
+      for (; k + 8 <= size; k += 8) {
+        std::uint64_t bytes = 0;
+        std::memcpy(&bytes, block + k, 8);
+        word |= zero_bytes(bytes ^ pattern) << k;
+      }
+      for (; k < size; ++k) {
+        word |= std::uint64_t{block[k] == values[v] ? 1U : 0U} << k;
+      }
+      out[v][w] = word;
+    }
+  }
+}
+
+inline void equal_masks_scalar(const char *cells, std::size_t n,
+                               const char *values, std::size_t count,
+                               std::uint64_t *const *out) {
+  equal_masks_from(cells, n, values, count, out, 0);
+}
+
+#if AOC_X86_DISPATCH
+AOC_TARGET_SSE42 inline void
+equal_masks_sse42(const char *cells, std::size_t n, const char *values,
+                  std::size_t count, std::uint64_t *const *out) {
+  const auto words = n / 64;
+  for (auto w = 0UL; w < words; ++w) {
+    __m128i bytes[4];
+    for (auto j = 0; j < 4; ++j) {
+      bytes[j] = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(cells + w * 64 + j * 16));
+    }
+    for (auto v = 0UL; v < count; ++v) {
+      const auto value = _mm_set1_epi8(values[v]);
+      std::uint64_t word = 0;
+      for (auto j = 0; j < 4; ++j) {
+        const auto mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes[j], value)));
+        word |= std::uint64_t{mask} << (j * 16);
+      }
+      out[v][w] = word;
+    }
+  }
+  equal_masks_from(cells, n, values, count, out, words);
+}
+
+AOC_TARGET_AVX2 inline void
+equal_masks_avx2(const char *cells, std::size_t n, const char *values,
+                 std::size_t count, std::uint64_t *const *out) {
+  const auto words = n / 64;
+  for (auto w = 0UL; w < words; ++w) {
+    const auto low = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(cells + w * 64));
+    const auto high = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(cells + w * 64 + 32));
+    for (auto v = 0UL; v < count; ++v) {
+      const auto value = _mm256_set1_epi8(values[v]);
+      const auto a = static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(low, value)));
+      const auto b = static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, value)));
+      out[v][w] = std::uint64_t{a} | (std::uint64_t{b} << 32);
+    }
+  }
+  equal_masks_from(cells, n, values, count, out, words);
+}
+
+AOC_TARGET_AVX512BW inline void
+equal_masks_avx512bw(const char *cells, std::size_t n, const char *values,
+                     std::size_t count, std::uint64_t *const *out) {
+  const auto words = n / 64;
+  for (auto w = 0UL; w < words; ++w) {
+    const auto bytes = _mm512_loadu_si512(cells + w * 64);
+    for (auto v = 0UL; v < count; ++v) {
+      out[v][w] =
+          _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(values[v]));
+    }
+  }
+  equal_masks_from(cells, n, values, count, out, words);
+}
+#endif
+
+} // namespace detail
+
+#if AOC_X86_DISPATCH
+inline constexpr cpu::Kernel<EqualMasksFn> equal_masks_kernel{
+    detail::equal_masks_scalar, detail::equal_masks_sse42,
+    detail::equal_masks_avx2, detail::equal_masks_avx512bw};
+#else
+inline constexpr cpu::Kernel<EqualMasksFn> equal_masks_kernel{
+    detail::equal_masks_scalar};
+#endif
+
+} // namespace aoc::kernels
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "aoc/sort.hpp"
+
+namespace aoc {
+
+// sorts more values than fit in memory: values are collected into runs of
+// half of `memory_budget`, the other half being the radix sort's scratch,
+// each run is sorted in RAM and spilled to an anonymous temporary file, and
+// finish() sets up a k-way merge that next() pulls from. the merge reads
+// every run through a block buffer sized so all of them together stay
+// within the same budget. to bound the number of open files, runs are kept
+// in generations: once `max_fan_in` runs of one generation pile up they are
+// merged into one run of the next, so every value is rewritten once per
+// generation rather than once per merge. when everything fits in one run
+// nothing touches the disk.
+//
+//   ExternalSorter<int> sorter{64 << 20};
+//   for (...) sorter.push(value);
+//   sorter.finish();
+//   for (int value; sorter.next(value);) ...
+template <std::integral T> class ExternalSorter {
+public:
+  static constexpr std::size_t max_fan_in = 64;
+
+  explicit ExternalSorter(std::size_t memory_budget)
+      : capacity(std::max<std::size_t>(memory_budget / 2 / sizeof(T), 1)) {
+    buffer.reserve(capacity);
+  }
+
+  void push(T value) {
+    if (buffer.size() == capacity) {
+      spill();
+    }
+    buffer.push_back(value);
+    ++count;
+  }
+
+  std::size_t size() const { return count; }
+  std::size_t run_count() const {
+    auto total = runs.size();
+    for (const auto &generation : generations) {
+      total += generation.size();
+    }
+    return total;
+  }
+
+  void finish() {
+    if (generations.empty()) {
+      sort_run(buffer);
+      return;
+    }
+    if (!buffer.empty()) {
+      spill();
+    }
+    // the final merge reads at most max_fan_in runs, the youngest
+    // generations are merged up until that holds
+    for (auto k = 0UL; k < generations.size() && run_count() > max_fan_in;
+         ++k) {
+      if (generations[k].size() > 1) {
+        collapse(k);
+      }
+    }
+    std::vector<T>{}.swap(buffer);
+
+    for (auto &generation : generations) {
+      std::move(generation.begin(), generation.end(),
+                std::back_inserter(runs));
+    }
+    generations.clear();
+    // the run buffer is gone, the whole budget goes to the read blocks
+    start_merge(runs, capacity * 2);
+  }
+
+  // the next value in ascending order, false once all were returned
+  bool next(T &value) {
+    if (runs.empty()) {
+      if (position == buffer.size()) {
+        return false;
+      }
+      value = buffer[position++];
+      return true;
+    }
+
+    return pop(runs, value);
+  }
+
+private:
+  struct FileCloser {
+    void operator()(std::FILE *file) const { std::fclose(file); }
+  };
+
+  struct Run {
+    std::unique_ptr<std::FILE, FileCloser> file;
+    std::vector<T> block{};
+    std::size_t position = 0;
+    std::size_t filled = 0;
+
+    bool next(T &value) {
+      if (position == filled) {
+        filled = std::fread(block.data(), sizeof(T), block.size(), file.get());
+        position = 0;
+        // a short read is only the end of the run if it was not an error
+        if (std::ferror(file.get())) {
+          throw std::system_error(errno, std::generic_category(),
+                                  "reading a sorted run");
+        }
+        if (filled == 0) {
+          return false;
+        }
+      }
+      value = block[position++];
+      return true;
+    }
+  };
+
+  static Run new_run() {
+    Run run{std::unique_ptr<std::FILE, FileCloser>(std::tmpfile())};
+    if (!run.file) {
+      throw std::system_error(errno, std::generic_category(),
+                              "creating a temporary run file");
+    }
+    return run;
+  }
+
+  static void write(Run &run, std::span<const T> values) {
+    if (std::fwrite(values.data(), sizeof(T), values.size(), run.file.get()) !=
+        values.size()) {
+      throw std::system_error(errno, std::generic_category(),
+                              "spilling a sorted run");
+    }
+  }
+
+  // radix sort in place, its scratch is the half of the budget the run
+  // leaves free; never the counting sort, whose histograms can outgrow the
+  // run itself
+  static void sort_run(std::span<T> values) {
+    sort::sort_with(values.size() <= sort::comparison_limit
+                        ? sort::Method::Comparison
+                        : sort::Method::Radix,
+                    values);
+  }
+
+  // every run of `group` gets an equal share of `budget` values to read
+  // through
+  void start_merge(std::vector<Run> &group, std::size_t budget) {
+    const auto block = std::max<std::size_t>(budget / group.size(), 64);
+    heads = {};
+    for (auto i = 0UL; i < group.size(); ++i) {
+      std::rewind(group[i].file.get());
+      group[i].block.resize(block);
+      group[i].position = 0;
+      group[i].filled = 0;
+      if (T value; group[i].next(value)) {
+        heads.push({value, i});
+      }
+    }
+  }
+
+  bool pop(std::vector<Run> &group, T &value) {
+    if (heads.empty()) {
+      return false;
+    }
+    const auto [head, run] = heads.top();
+    heads.pop();
+    value = head;
+    if (T following; group[run].next(following)) {
+      heads.push({following, run});
+    }
+    return true;
+  }
+
+  void spill() {
+    sort_run(buffer);
+    auto run = new_run();
+    write(run, buffer);
+    if (generations.empty()) {
+      generations.emplace_back();
+    }
+    generations[0].push_back(std::move(run));
+    buffer.clear();
+
+    if (generations[0].size() == max_fan_in) {
+      collapse(0);
+    }
+  }
+
+  // merges the runs of generation `k` into one run of generation k + 1,
+  // through the (now empty) run buffer as write block and the scratch half
+  // of the budget as read blocks, and carries on up if that one fills too
+  void collapse(std::size_t k) {
+    auto group = std::move(generations[k]);
+    generations[k].clear();
+    auto merged = new_run();
+    start_merge(group, capacity);
+    buffer.resize(capacity);
+    auto filled = 0UL;
+    for (T value; pop(group, value);) {
+      buffer[filled++] = value;
+      if (filled == buffer.size()) {
+        write(merged, buffer);
+        filled = 0;
+      }
+    }
+    write(merged, std::span<const T>(buffer).first(filled));
+    buffer.clear();
+    group.clear();
+
+    if (generations.size() == k + 1) {
+      generations.emplace_back();
+    }
+    generations[k + 1].push_back(std::move(merged));
+    if (generations[k + 1].size() == max_fan_in) {
+      collapse(k + 1);
+    }
+  }
+
+  using Head = std::pair<T, std::size_t>;
+
+  std::size_t capacity;
+  std::size_t count = 0;
+  std::vector<T> buffer{};
+  std::size_t position = 0;
+  // spilled runs by the number of merges they went through
+  std::vector<std::vector<Run>> generations{};
+  // the runs of the final merge, once finish() was called
+  std::vector<Run> runs{};
+  std::priority_queue<Head, std::vector<Head>, std::greater<>> heads{};
+};
+
+} // namespace aoc
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// open addressing hash map for integer keys: one flat array, linear
+// probing, power of two capacity, no erase. meant for counting, where
+// std::unordered_map spends most of its time allocating nodes.
+template <std::integral Key, typename Value> class FlatMap {
+public:
+  explicit FlatMap(std::size_t expected = 16) { rehash(expected * 2); }
+
+  // default constructs the value on first use
+  Value &operator[](Key key) {
+    if ((count + 1) * 4 > slots.size() * 3) {
+      rehash(slots.size() * 2);
+    }
+    auto i = bucket(key);
+    while (used[i] != 0) {
+      if (slots[i].key == key) {
+        return slots[i].value;
+      }
+      i = (i + 1) & mask;
+    }
+    used[i] = 1;
+    ++count;
+    slots[i] = {key, Value{}};
+    return slots[i].value;
+  }
+
+  const Value *find(Key key) const {
+    for (auto i = bucket(key); used[i] != 0; i = (i + 1) & mask) {
+      if (slots[i].key == key) {
+        return &slots[i].value;
+      }
+    }
+    return nullptr;
+  }
+
+  std::size_t size() const { return count; }
+
+  // visit(key, value) in no particular order
+  template <typename Visitor> void for_each(Visitor visit) const {
+    for (auto i = 0UL; i < slots.size(); ++i) {
+      if (used[i] != 0) {
+        visit(slots[i].key, slots[i].value);
+      }
+    }
+  }
+
+private:
+  struct Slot {
+    Key key;
+    Value value;
+  };
+
+  // fibonacci hashing, spreads sequential ids over the whole table
+  std::size_t bucket(Key key) const {
+    return static_cast<std::size_t>(
+        (static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> shift);
+  }
+
+  void rehash(std::size_t capacity) {
+    capacity = std::bit_ceil(std::max<std::size_t>(capacity, 16));
+    auto old_slots = std::exchange(slots, std::vector<Slot>(capacity));
+    auto old_used = std::exchange(used, std::vector<std::uint8_t>(capacity));
+    mask = capacity - 1;
+    shift = 64 - std::countr_zero(capacity);
+    count = 0;
+    for (auto i = 0UL; i < old_slots.size(); ++i) {
+      if (old_used[i] != 0) {
+        (*this)[old_slots[i].key] = std::move(old_slots[i].value);
+      }
+    }
+  }
+
+  std::vector<Slot> slots{};
+  std::vector<std::uint8_t> used{};
+  std::size_t mask = 0;
+  unsigned int shift = 64;
+  std::size_t count = 0;
+};
+
+} // namespace aoc
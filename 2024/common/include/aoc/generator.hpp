@@ -0,0 +1,112 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace aoc {
+
+// minimal std::generator stand-in: libstdc++ only ships <generator> from
+// GCC 14, and we only ever need a move-only, single-pass input range
+template <typename T> class generator {
+public:
+  struct promise_type {
+    std::optional<T> current{};
+    std::exception_ptr exception{};
+
+    generator get_return_object() {
+      return generator{
+          std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    template <typename U = T> std::suspend_always yield_value(U &&value) {
+      current.emplace(std::forward<U>(value));
+      return {};
+    }
+
+    void return_void() {}
+    void unhandled_exception() { exception = std::current_exception(); }
+
+    // generators only produce values
+    template <typename U> std::suspend_never await_transform(U &&) = delete;
+  };
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+
+    iterator() = default;
+    explicit iterator(handle_type handle_) : handle(handle_) {}
+
+    T &operator*() const { return *handle.promise().current; }
+    T *operator->() const { return &*handle.promise().current; }
+
+    iterator &operator++() {
+      advance(handle);
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator &it, std::default_sentinel_t) {
+      return !it.handle || it.handle.done();
+    }
+
+  private:
+    handle_type handle{};
+  };
+
+  generator() = default;
+  generator(generator &&other) noexcept
+      : handle(std::exchange(other.handle, {})) {}
+  generator &operator=(generator &&other) noexcept {
+    if (this != &other) {
+      reset();
+      handle = std::exchange(other.handle, {});
+    }
+    return *this;
+  }
+  generator(const generator &) = delete;
+  generator &operator=(const generator &) = delete;
+  ~generator() { reset(); }
+
+  // single pass: the first call to begin() produces the first value, later
+  // calls pick up where the last iterator stopped, and a finished coroutine
+  // is never resumed again
+  iterator begin() {
+    if (handle && !handle.done()) {
+      advance(handle);
+    }
+    return iterator{handle};
+  }
+  std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  explicit generator(handle_type handle_) : handle(handle_) {}
+
+  static void advance(handle_type handle) {
+    handle.promise().current.reset();
+    handle.resume();
+    if (handle.promise().exception) {
+      std::rethrow_exception(std::exchange(handle.promise().exception, {}));
+    }
+  }
+
+  void reset() {
+    if (handle) {
+      handle.destroy();
+      handle = {};
+    }
+  }
+
+  handle_type handle{};
+};
+
+} // namespace aoc
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aoc/text.hpp"
+
+namespace aoc {
+
+// rows x cols values in one row major block, for the puzzles that come as a
+// picture. rows are spans into it, so a row can be handed to anything that
+// takes a contiguous range.
+template <typename T> class Grid {
+public:
+  Grid() = default;
+  Grid(std::size_t rows_, std::size_t cols_, T fill = T{})
+      : row_count(rows_), col_count(cols_), cells(rows_ * cols_, fill) {}
+
+  std::size_t rows() const { return row_count; }
+  std::size_t cols() const { return col_count; }
+  std::size_t size() const { return cells.size(); }
+
+  // signed so neighbours can be probed without casting first
+  bool in_bounds(std::ptrdiff_t r, std::ptrdiff_t c) const {
+    return r >= 0 && c >= 0 && static_cast<std::size_t>(r) < row_count &&
+           static_cast<std::size_t>(c) < col_count;
+  }
+
+  T &operator()(std::size_t r, std::size_t c) { return cells[r * col_count + c]; }
+  const T &operator()(std::size_t r, std::size_t c) const {
+    return cells[r * col_count + c];
+  }
+
+  std::span<T> row(std::size_t r) {
+    return std::span<T>(cells).subspan(r * col_count, col_count);
+  }
+  std::span<const T> row(std::size_t r) const {
+    return std::span<const T>(cells).subspan(r * col_count, col_count);
+  }
+
+  T *data() { return cells.data(); }
+  const T *data() const { return cells.data(); }
+
+private:
+  std::size_t row_count = 0;
+  std::size_t col_count = 0;
+  std::vector<T> cells{};
+};
+
+// one row per line, as wide as the longest line with the shorter ones padded
+// with `fill`, which should be a byte the puzzle never looks for
+inline Grid<char> parse_grid(std::string_view text, char fill = '.') {
+  std::vector<std::string_view> lines{};
+  std::size_t width = 0;
+  while (!text.empty()) {
+    auto line = text.substr(0, text.find('\n'));
+    text.remove_prefix(std::min(line.size() + 1, text.size()));
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    width = std::max(width, line.size());
+    lines.push_back(line);
+  }
+
+  Grid<char> grid(lines.size(), width, fill);
+  for (auto r = 0UL; r < lines.size(); ++r) {
+    std::copy(lines[r].begin(), lines[r].end(), grid.row(r).begin());
+  }
+  return grid;
+}
+
+// "-" reads stdin
+inline Grid<char> read_grid(std::string_view file, char fill = '.') {
+  return parse_grid(text::read_file(file), fill);
+}
+
+} // namespace aoc
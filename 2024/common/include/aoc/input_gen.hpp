@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// random puzzle inputs in the same shape as the real ones, used to train PGO
+// builds, to benchmark and to cross-check solvers. `size` is per day: lines
+// for line based days, the side of the grid for grid days, bytes for day 3.
+namespace aoc::gen {
+
+using Rng = std::mt19937_64;
+
+template <typename T> T uniform(Rng &rng, T min, T max) {
+  return std::uniform_int_distribution<T>(min, max)(rng);
+}
+
+inline bool chance(Rng &rng, double p) {
+  return std::bernoulli_distribution(p)(rng);
+}
+
+template <typename Container>
+const auto &pick(Rng &rng, const Container &values) {
+  return values[uniform<std::size_t>(rng, 0, values.size() - 1)];
+}
+
+template <typename Cell>
+void grid(std::ostream &out, Rng &rng, std::size_t rows, std::size_t cols,
+          const Cell &cell) {
+  std::string line(cols, '.');
+  for (auto i = 0UL; i < rows; ++i) {
+    std::generate(line.begin(), line.end(), [&] { return cell(rng); });
+    out << line << '\n';
+  }
+}
+
+// two columns of 5 digit location ids
+inline void day1(std::ostream &out, Rng &rng, std::size_t lines) {
+  for (auto i = 0UL; i < lines; ++i) {
+    out << uniform(rng, 10000, 99999) << "   " << uniform(rng, 10000, 99999)
+        << '\n';
+  }
+}
+
+// 5 to 8 levels per report, mostly monotonic with steps of 1 to 3 and the
+// occasional bad level so every checker path gets exercised
+inline void day2(std::ostream &out, Rng &rng, std::size_t lines) {
+  for (auto i = 0UL; i < lines; ++i) {
+    const auto levels = uniform(rng, 5, 8);
+    const auto direction = chance(rng, 0.5) ? 1 : -1;
+    auto level = direction > 0 ? uniform(rng, 1, 40) : uniform(rng, 50, 99);
+    for (auto j = 0; j < levels; ++j) {
+      if (j != 0) {
+        out << ' ';
+        level += direction * uniform(rng, 1, 3);
+      }
+      auto value = level;
+      if (chance(rng, 0.08)) {
+        value += uniform(rng, -4, 4);
+      }
+      out << std::max(value, 0);
+    }
+    out << '\n';
+  }
+}
+
+// corrupted memory: noise built from the same characters as the real
+// instructions, with valid and almost valid mul/do/don't scattered through
+inline void day3(std::ostream &out, Rng &rng, std::size_t bytes) {
+  constexpr auto noise = std::string_view("mul(,)don't()0123456789 []{}<>!@#$"
+                                          "%^&*-+=?/;:'\"~_abcdefghijklmnopqrs"
+                                          "tuvwxyz");
+  constexpr auto near_misses = std::array<std::string_view, 8>{
+      "mul(4*", "mul[3,7]", "mul ( 2 , 4 )", "mul(1234,5)",
+      "mul(2,)", "do(", "don't(", "mul(6,9!"};
+
+  std::string line{};
+  auto written = 0UL;
+  while (written < bytes) {
+    line.clear();
+    const auto length = std::min<std::size_t>(bytes - written, 4096);
+    while (line.size() + 1 < length) {
+      const auto roll = uniform(rng, 0, 99);
+      if (roll < 6) {
+        line += "mul(" + std::to_string(uniform(rng, 0, 999)) + "," +
+                std::to_string(uniform(rng, 0, 999)) + ")";
+      } else if (roll < 7) {
+        line += "do()";
+      } else if (roll < 8) {
+        line += "don't()";
+      } else if (roll < 10) {
+        line += pick(rng, near_misses);
+      } else {
+        line += pick(rng, noise);
+      }
+    }
+    line.resize(length > 0 ? length - 1 : 0);
+    out << line << '\n';
+    written += line.size() + 1;
+  }
+}
+
+// square letter grid of X, M, A and S
+inline void day4(std::ostream &out, Rng &rng, std::size_t side) {
+  constexpr auto letters = std::string_view("XMAS");
+  grid(out, rng, side, side, [&](Rng &r) { return pick(r, letters); });
+}
+
+// rules follow one hidden total order over the pages so every update can be
+// fixed, updates have an odd number of distinct pages
+inline void day5(std::ostream &out, Rng &rng, std::size_t updates) {
+  std::vector<unsigned int> pages(90);
+  std::iota(pages.begin(), pages.end(), 10U);
+  std::shuffle(pages.begin(), pages.end(), rng);
+  pages.resize(49);
+
+  std::vector<std::pair<unsigned int, unsigned int>> rules{};
+  for (auto i = 0UL; i < pages.size(); ++i) {
+    for (auto j = i + 1; j < pages.size(); ++j) {
+      rules.emplace_back(pages[i], pages[j]);
+    }
+  }
+  std::shuffle(rules.begin(), rules.end(), rng);
+  for (const auto &[before, after] : rules) {
+    out << before << '|' << after << '\n';
+  }
+  out << '\n';
+
+  for (auto i = 0UL; i < updates; ++i) {
+    auto update = pages;
+    std::shuffle(update.begin(), update.end(), rng);
+    update.resize(2 * uniform(rng, 2UL, 11UL) + 1);
+    if (chance(rng, 0.5)) {
+      std::sort(update.begin(), update.end(), [&pages](auto a, auto b) {
+        return std::find(pages.begin(), pages.end(), a) <
+               std::find(pages.begin(), pages.end(), b);
+      });
+    }
+    for (auto j = 0UL; j < update.size(); ++j) {
+      out << (j == 0 ? "" : ",") << update[j];
+    }
+    out << '\n';
+  }
+}
+
+// about half the equations are built from a real +, * or || chain
+inline void day7(std::ostream &out, Rng &rng, std::size_t lines) {
+  std::vector<unsigned long> coefficients{};
+  for (auto i = 0UL; i < lines; ++i) {
+    coefficients.resize(uniform(rng, 2UL, 6UL));
+    std::generate(coefficients.begin(), coefficients.end(),
+                  [&] { return uniform(rng, 1UL, 99UL); });
+
+    auto result = coefficients[0];
+    for (auto j = 1UL; j < coefficients.size(); ++j) {
+      switch (uniform(rng, 0, 2)) {
+      case 0:
+        result += coefficients[j];
+        break;
+      case 1:
+        result *= coefficients[j];
+        break;
+      default:
+        result = std::stoul(std::to_string(result) +
+                            std::to_string(coefficients[j]));
+        break;
+      }
+    }
+    if (chance(rng, 0.5)) {
+      result += uniform(rng, 1UL, 5UL);
+    }
+
+    out << result << ':';
+    for (const auto k : coefficients) {
+      out << ' ' << k;
+    }
+    out << '\n';
+  }
+}
+
+// mostly empty map with a handful of antenna frequencies
+inline void day8(std::ostream &out, Rng &rng, std::size_t side) {
+  constexpr auto frequencies = std::string_view("0aA");
+  grid(out, rng, side, side, [&](Rng &r) {
+    return chance(r, 0.02) ? pick(r, frequencies) : '.';
+  });
+}
+
+// a single dense disk map line
+inline void day9(std::ostream &out, Rng &rng, std::size_t digits) {
+  for (auto i = 0UL; i < digits; ++i) {
+    out << (i % 2 == 0 ? uniform(rng, 1, 9) : uniform(rng, 0, 9));
+  }
+  out << '\n';
+}
+
+// topographic map of heights 0 to 9
+inline void day10(std::ostream &out, Rng &rng, std::size_t side) {
+  grid(out, rng, side, side,
+       [&](Rng &r) { return static_cast<char>('0' + uniform(r, 0, 9)); });
+}
+
+// a single line of stones
+inline void day11(std::ostream &out, Rng &rng, std::size_t stones) {
+  for (auto i = 0UL; i < stones; ++i) {
+    out << (i == 0 ? "" : " ") << uniform(rng, 0UL, 999999UL);
+  }
+  out << '\n';
+}
+
+// garden plots, few plant types so regions actually form
+inline void day12(std::ostream &out, Rng &rng, std::size_t side) {
+  grid(out, rng, side, side,
+       [&](Rng &r) { return static_cast<char>('A' + uniform(r, 0, 3)); });
+}
+
+struct Generator {
+  unsigned int day;
+  void (*generate)(std::ostream &, Rng &, std::size_t);
+  // big enough to be representative, small enough for instrumented builds
+  std::size_t training_size;
+  // largest input tools/verify tries, small keeps counterexamples readable
+  std::size_t check_size;
+};
+
+// day 6 is missing on purpose: a random map can trap the guard in a loop,
+// which never terminates in part 1
+inline constexpr auto generators = std::array{
+    Generator{1, day1, 20000, 64},     Generator{2, day2, 100000, 64},
+    Generator{3, day3, 1 << 20, 2048}, Generator{4, day4, 1000, 16},
+    Generator{5, day5, 2000, 32},      Generator{7, day7, 2000, 32},
+    Generator{8, day8, 200, 16},       Generator{9, day9, 4000, 64},
+    Generator{10, day10, 200, 16},     Generator{11, day11, 16, 4},
+    Generator{12, day12, 100, 16},
+};
+
+inline const Generator *find(unsigned int day) {
+  for (const auto &k : generators) {
+    if (k.day == day) {
+      return &k;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace aoc::gen
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fork/join over contiguous chunks with plain std::threads, which is all the
+// solvers need (libstdc++'s parallel algorithms pull in TBB)
+namespace aoc::par {
+
+inline std::size_t hardware_threads() {
+  const auto n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+struct Range {
+  std::size_t begin;
+  std::size_t end;
+
+  std::size_t size() const { return end - begin; }
+};
+
+// the i-th of `chunks` nearly equal pieces of [0, n)
+constexpr Range chunk(std::size_t n, std::size_t chunks, std::size_t i) {
+  const auto base = n / chunks;
+  const auto extra = n % chunks;
+  const auto begin = i * base + std::min(i, extra);
+  return {begin, begin + base + (i < extra ? 1 : 0)};
+}
+
+// as many chunks as there are threads, but none smaller than `min_chunk`,
+// so small inputs stay on the calling thread
+inline std::size_t chunk_count(std::size_t n, std::size_t min_chunk,
+                               std::size_t threads = hardware_threads()) {
+  return std::max<std::size_t>(
+      1, std::min(threads, n / std::max<std::size_t>(min_chunk, 1)));
+}
+
+// calls fn(i, chunk(n, chunks, i)) for every chunk, chunk 0 on the calling
+// thread; the first exception thrown by any chunk is rethrown after the join
+template <typename Fn>
+void for_each_chunk(std::size_t n, std::size_t chunks, Fn fn) {
+  if (chunks <= 1) {
+    fn(std::size_t{0}, Range{0, n});
+    return;
+  }
+
+  std::mutex mutex{};
+  std::exception_ptr error{};
+  const auto guarded = [&](std::size_t i) {
+    try {
+      fn(i, chunk(n, chunks, i));
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers{};
+    workers.reserve(chunks - 1);
+    for (auto i = 1UL; i < chunks; ++i) {
+      workers.emplace_back(guarded, i);
+    }
+    guarded(0);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace aoc::par
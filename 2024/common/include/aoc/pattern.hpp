@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+// compile-time token patterns for grammars like day 3's corrupted memory, in
+// the spirit of ctre but only what the puzzles need: literal bytes and
+// captured decimal numbers. a pattern literal is parsed at compile time
+// into a fixed sequence of elements and the matcher is unrolled over it, so
+// there is no regex compilation at runtime and no allocation.
+//
+//   any byte     matches itself, a backslash escapes the next one
+//   \d{m,n}      a number of m to n digits, captured as its value
+//   \d{n}, \d    exactly n digits, exactly one
+//
+//   using Grammar = aoc::pattern::Grammar<"mul(\\d{1,3},\\d{1,3})", "do()">;
+//   Grammar::scan(text, [](std::size_t which, const auto &values) { ... });
+//
+// a number is matched greedily, which is exact because it must be followed
+// by a byte that is not a digit (or end the pattern); that, an empty pattern
+// or a bad repeat count is a compile error.
+namespace aoc::pattern {
+
+template <std::size_t N> struct Literal {
+  char text[N]{};
+
+  consteval Literal(const char (&s)[N]) { std::copy_n(s, N, text); }
+
+  constexpr std::string_view view() const { return {text, N - 1}; }
+};
+
+struct Element {
+  bool number = false;
+  char byte = 0;
+  std::size_t min = 1;
+  std::size_t max = 1;
+};
+
+constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+namespace detail {
+
+// throwing during constant evaluation is what turns these into errors
+consteval void expect(bool condition, const char *) {
+  if (!condition) {
+    throw "invalid pattern";
+  }
+}
+
+consteval std::size_t parse_count(std::string_view &p) {
+  expect(!p.empty() && is_digit(p[0]), "expected a repeat count");
+  std::size_t count = 0;
+  while (!p.empty() && is_digit(p[0])) {
+    count = count * 10 + static_cast<std::size_t>(p[0] - '0');
+    p.remove_prefix(1);
+  }
+  return count;
+}
+
+// writes the elements to `out` when given, returns how many there are
+consteval std::size_t parse(std::string_view p, Element *out) {
+  std::size_t count = 0;
+  while (!p.empty()) {
+    Element element{};
+    if (p.starts_with("\\d")) {
+      p.remove_prefix(2);
+      element.number = true;
+      if (p.starts_with('{')) {
+        p.remove_prefix(1);
+        element.min = parse_count(p);
+        element.max = element.min;
+        if (p.starts_with(',')) {
+          p.remove_prefix(1);
+          element.max = parse_count(p);
+        }
+        expect(p.starts_with('}'), "unclosed repeat count");
+        p.remove_prefix(1);
+      }
+      // 19 digits always fit a 64 bit value
+      expect(element.min >= 1 && element.min <= element.max &&
+                 element.max <= 19,
+             "bad repeat count");
+      expect(p.empty() || (!p.starts_with("\\d") && !is_digit(p[0]) &&
+                           !(p[0] == '\\' && p.size() > 1 && is_digit(p[1]))),
+             "a number must be followed by a byte that is not a digit");
+    } else {
+      if (p[0] == '\\') {
+        p.remove_prefix(1);
+        expect(!p.empty(), "dangling escape");
+      }
+      element.byte = p[0];
+      p.remove_prefix(1);
+    }
+    if (out != nullptr) {
+      out[count] = element;
+    }
+    ++count;
+  }
+  expect(count > 0, "empty pattern");
+  return count;
+}
+
+template <Literal P> consteval auto compile() {
+  std::array<Element, parse(P.view(), nullptr)> elements{};
+  parse(P.view(), elements.data());
+  return elements;
+}
+
+} // namespace detail
+
+template <Literal P> struct Pattern {
+  static constexpr auto elements = detail::compile<P>();
+  static constexpr std::size_t captures = static_cast<std::size_t>(
+      std::count_if(elements.begin(), elements.end(),
+                    [](const Element &e) { return e.number; }));
+
+  // the bytes a match can start with
+  static constexpr std::array<bool, 256> first = [] {
+    std::array<bool, 256> bytes{};
+    if (elements[0].number) {
+      for (auto c = '0'; c <= '9'; ++c) {
+        bytes[static_cast<unsigned char>(c)] = true;
+      }
+    } else {
+      bytes[static_cast<unsigned char>(elements[0].byte)] = true;
+    }
+    return bytes;
+  }();
+
+  // length of the match at the front of `text`, 0 when there is none; the
+  // numbers go to values[0, captures) in pattern order
+  template <typename Values>
+  static constexpr std::size_t match(std::string_view text, Values &values) {
+    return match_from<0, 0>(text, 0, values);
+  }
+
+private:
+  template <std::size_t E, std::size_t C, typename Values>
+  static constexpr std::size_t match_from(std::string_view text,
+                                          std::size_t at, Values &values) {
+    if constexpr (E == elements.size()) {
+      return at;
+    } else if constexpr (!elements[E].number) {
+      if (at >= text.size() || text[at] != elements[E].byte) {
+        return 0;
+      }
+      return match_from<E + 1, C>(text, at + 1, values);
+    } else {
+      std::uint64_t value = 0;
+      auto digits = 0UL;
+      while (digits < elements[E].max && at + digits < text.size() &&
+             is_digit(text[at + digits])) {
+        value = value * 10 + static_cast<std::uint64_t>(text[at + digits] - '0');
+        ++digits;
+      }
+      if (digits < elements[E].min) {
+        return 0;
+      }
+      values[C] = value;
+      return match_from<E + 1, C + 1>(text, at + digits, values);
+    }
+  }
+};
+
+// alternatives tried in order at every offset and scanning resumes after a
+// match, the same tokens std::regex_iterator finds for "P0|P1|..."
+template <Literal... Ps> class Grammar {
+  using Alternatives = std::tuple<Pattern<Ps>...>;
+
+public:
+  static constexpr std::size_t size = sizeof...(Ps);
+  static constexpr std::size_t max_captures =
+      std::max({std::size_t{0}, Pattern<Ps>::captures...});
+  using Values = std::array<std::uint64_t, max_captures>;
+
+  static constexpr std::array<bool, 256> first = [] {
+    std::array<bool, 256> bytes{};
+    for (auto c = 0UL; c < bytes.size(); ++c) {
+      bytes[c] = (Pattern<Ps>::first[c] || ...);
+    }
+    return bytes;
+  }();
+
+  // visit(which, values) for every token, `which` being the index of the
+  // alternative that matched; only its own captures in `values` are set
+  template <typename Visitor>
+  static constexpr void scan(std::string_view text, Visitor &&visit) {
+    for (auto i = 0UL; i < text.size();) {
+      if (!first[static_cast<unsigned char>(text[i])]) {
+        ++i;
+        continue;
+      }
+      const auto length =
+          match_at(text.substr(i), visit, std::make_index_sequence<size>{});
+      i += length == 0 ? 1 : length;
+    }
+  }
+
+private:
+  template <typename Visitor, std::size_t... I>
+  static constexpr std::size_t match_at(std::string_view text,
+                                        Visitor &visit,
+                                        std::index_sequence<I...>) {
+    std::size_t length = 0;
+    Values values{};
+    // the fold stops at the first alternative that matches
+    ((length = std::tuple_element_t<I, Alternatives>::match(text, values),
+      length != 0 ? (visit(I, std::as_const(values)), true) : false) ||
+     ...);
+    return length;
+  }
+};
+
+} // namespace aoc::pattern
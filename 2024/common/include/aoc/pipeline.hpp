@@ -0,0 +1,197 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "aoc/generator.hpp"
+
+// lazy read -> parse -> solve pipelines built from generators, e.g.
+//
+//   for (auto &report : aoc::pipe::read_lines("input") |
+//                           aoc::pipe::transform(parse) |
+//                           aoc::pipe::buffered(256)) { ... }
+//
+// every stage pulls one value at a time from the previous one, so memory is
+// bounded by the buffered() capacity instead of by the input size
+namespace aoc::pipe {
+
+inline generator<std::string> read_lines(std::istream &stream) {
+  std::string line;
+  while (std::getline(stream, line)) {
+    co_yield std::move(line);
+    line.clear();
+  }
+}
+
+namespace detail {
+inline generator<std::string> read_lines(std::ifstream stream) {
+  std::string line;
+  while (std::getline(stream, line)) {
+    co_yield std::move(line);
+    line.clear();
+  }
+}
+} // namespace detail
+
+// "-" reads from stdin, anything else is opened eagerly so a missing file
+// throws here instead of on the first iteration
+inline generator<std::string> read_lines(const std::string_view &file) {
+  if (file == "-") {
+    return read_lines(std::cin);
+  }
+  std::ifstream stream{std::string(file)};
+  if (!stream.is_open()) {
+    throw std::system_error(
+        std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+  return detail::read_lines(std::move(stream));
+}
+
+template <typename T> class BoundedQueue {
+public:
+  explicit BoundedQueue(std::size_t capacity_)
+      : capacity(capacity_ == 0 ? 1 : capacity_) {}
+
+  // returns false if the consumer went away while we were waiting for room
+  bool push(T value, std::stop_token stop) {
+    std::unique_lock lock(mutex);
+    if (!not_full.wait(lock, stop,
+                       [this] { return items.size() < capacity; })) {
+      return false;
+    }
+    items.push_back(std::move(value));
+    not_empty.notify_one();
+    return true;
+  }
+
+  // nullopt once the producer closed the queue and everything was drained
+  std::optional<T> pop() {
+    std::unique_lock lock(mutex);
+    not_empty.wait(lock, [this] { return !items.empty() || closed; });
+    if (items.empty()) {
+      if (error) {
+        std::rethrow_exception(std::exchange(error, {}));
+      }
+      return std::nullopt;
+    }
+    auto value = std::move(items.front());
+    items.pop_front();
+    not_full.notify_one();
+    return value;
+  }
+
+  void close(std::exception_ptr error_ = {}) {
+    std::lock_guard lock(mutex);
+    closed = true;
+    error = error_;
+    not_empty.notify_all();
+  }
+
+private:
+  std::mutex mutex{};
+  std::condition_variable_any not_empty{};
+  std::condition_variable_any not_full{};
+  std::deque<T> items{};
+  std::size_t capacity;
+  bool closed = false;
+  std::exception_ptr error{};
+};
+
+template <typename T, typename Functor>
+generator<std::remove_cvref_t<std::invoke_result_t<Functor &, T &>>>
+transform(generator<T> source, Functor fn) {
+  for (auto &value : source) {
+    co_yield std::invoke(fn, value);
+  }
+}
+
+template <typename T, typename Predicate>
+generator<T> filter(generator<T> source, Predicate pred) {
+  for (auto &value : source) {
+    if (std::invoke(pred, std::as_const(value))) {
+      co_yield std::move(value);
+    }
+  }
+}
+
+// runs `source` on its own thread, at most `capacity` values ahead of the
+// consumer; this is what lets parsing overlap with I/O and solving.
+//
+// a consumer that stops early requests a stop, and the producer checks for
+// it before every value it hands over. it cannot break out of a read that
+// is already blocked though: over stdin or a pipe, destroying the stage
+// waits until the next line or EOF arrives. read a file, or drain the input,
+// where that matters.
+template <typename T>
+generator<T> buffered(generator<T> source, std::size_t capacity) {
+  BoundedQueue<T> queue{capacity};
+
+  // declared after the queue: destroying the consumer early requests a stop
+  // and joins the producer before the queue goes away
+  std::jthread producer(
+      [&queue, source = std::move(source)](std::stop_token stop) mutable {
+        try {
+          for (auto &value : source) {
+            if (stop.stop_requested() ||
+                !queue.push(std::move(value), stop)) {
+              return;
+            }
+          }
+          queue.close();
+        } catch (...) {
+          queue.close(std::current_exception());
+        }
+      });
+
+  while (auto value = queue.pop()) {
+    co_yield std::move(*value);
+  }
+}
+
+// pipe adaptors so stages read left to right
+template <typename Functor> struct TransformStage {
+  Functor fn;
+};
+template <typename Predicate> struct FilterStage {
+  Predicate pred;
+};
+struct BufferedStage {
+  std::size_t capacity;
+};
+
+template <typename Functor> auto transform(Functor fn) {
+  return TransformStage<Functor>{std::move(fn)};
+}
+template <typename Predicate> auto filter(Predicate pred) {
+  return FilterStage<Predicate>{std::move(pred)};
+}
+inline auto buffered(std::size_t capacity) { return BufferedStage{capacity}; }
+
+template <typename T, typename Functor>
+auto operator|(generator<T> &&source, TransformStage<Functor> stage) {
+  return transform(std::move(source), std::move(stage.fn));
+}
+template <typename T, typename Predicate>
+auto operator|(generator<T> &&source, FilterStage<Predicate> stage) {
+  return filter(std::move(source), std::move(stage.pred));
+}
+template <typename T>
+auto operator|(generator<T> &&source, BufferedStage stage) {
+  return buffered(std::move(source), stage.capacity);
+}
+
+} // namespace aoc::pipe
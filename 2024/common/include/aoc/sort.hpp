@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "aoc/parallel.hpp"
+
+// integer sorting that looks at the value range first: a counting sort when
+// the histogram is small next to the input, an LSD radix sort over the bits
+// of (value - min) otherwise, std::sort for tiny inputs. `threads` > 1 runs
+// the histogram and scatter passes on that many chunks.
+namespace aoc::sort {
+
+enum class Method {
+  Comparison,
+  Counting,
+  Radix,
+};
+
+constexpr std::string_view to_string(Method method) {
+  switch (method) {
+  case Method::Comparison:
+    return "comparison";
+  case Method::Counting:
+    return "counting";
+  case Method::Radix:
+    return "radix";
+  }
+  return "unknown";
+}
+
+// below this std::sort wins over building any histogram
+inline constexpr std::size_t comparison_limit = 64;
+// a histogram this size is cheap whatever the input size
+inline constexpr std::uint64_t counting_limit = 1 << 16;
+// and one this big never is
+inline constexpr std::uint64_t counting_max = 1 << 24;
+// chunks smaller than this are not worth a thread
+inline constexpr std::size_t min_chunk = 1 << 16;
+
+template <std::integral T> struct Bounds {
+  T min;
+  T max;
+};
+
+// distance between max and min, max - min + 1 may not fit in a T
+template <std::integral T> constexpr std::uint64_t spread(Bounds<T> bounds) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(static_cast<U>(bounds.max) -
+                        static_cast<U>(bounds.min));
+}
+
+template <std::integral T>
+constexpr Method choose(std::size_t n, Bounds<T> bounds) {
+  if (n <= comparison_limit) {
+    return Method::Comparison;
+  }
+  const auto distance = spread(bounds);
+  if (distance < counting_limit ||
+      (distance < counting_max && distance / 4 < n)) {
+    return Method::Counting;
+  }
+  return Method::Radix;
+}
+
+// data must not be empty
+template <std::integral T>
+Bounds<T> bounds(std::span<const T> data, std::size_t threads = 1) {
+  const auto chunks = par::chunk_count(data.size(), min_chunk, threads);
+  std::vector<Bounds<T>> partial(chunks, Bounds<T>{data[0], data[0]});
+  par::for_each_chunk(data.size(), chunks, [&](auto i, par::Range range) {
+    const auto [min, max] = std::minmax_element(data.begin() + range.begin,
+                                                data.begin() + range.end);
+    partial[i] = {*min, *max};
+  });
+
+  auto result = partial[0];
+  for (const auto &k : partial) {
+    result.min = std::min(result.min, k.min);
+    result.max = std::max(result.max, k.max);
+  }
+  return result;
+}
+
+namespace detail {
+
+template <std::integral T> T from_key(Bounds<T> bounds, std::uint64_t key) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<T>(static_cast<U>(static_cast<U>(bounds.min) + key));
+}
+
+template <std::integral T>
+std::uint64_t to_key(Bounds<T> bounds, T value) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(static_cast<U>(value) - static_cast<U>(bounds.min));
+}
+
+// only keys are sorted, so counting sort is a histogram written back out
+template <std::integral T>
+void counting(std::span<T> data, Bounds<T> bounds, std::size_t threads) {
+  const auto buckets = spread(bounds) + 1;
+  // keep the per chunk histograms from outgrowing the data
+  const auto chunks =
+      std::min(par::chunk_count(data.size(), min_chunk, threads),
+               std::max<std::size_t>(1, data.size() / buckets));
+
+  // one histogram per chunk, then each chunk owns a slice of the buckets to
+  // sum up and later to write out
+  std::vector<std::size_t> counts(chunks * buckets);
+  par::for_each_chunk(data.size(), chunks, [&](auto i, par::Range range) {
+    auto *histogram = counts.data() + i * buckets;
+    for (auto j = range.begin; j < range.end; ++j) {
+      ++histogram[to_key(bounds, data[j])];
+    }
+  });
+
+  std::vector<std::size_t> totals(buckets);
+  std::vector<std::size_t> slice_sizes(chunks);
+  par::for_each_chunk(buckets, chunks, [&](auto i, par::Range range) {
+    std::size_t size = 0;
+    for (auto k = range.begin; k < range.end; ++k) {
+      for (auto c = 0UL; c < chunks; ++c) {
+        totals[k] += counts[c * buckets + k];
+      }
+      size += totals[k];
+    }
+    slice_sizes[i] = size;
+  });
+
+  std::vector<std::size_t> slice_offsets(chunks);
+  std::exclusive_scan(slice_sizes.begin(), slice_sizes.end(),
+                      slice_offsets.begin(), std::size_t{0});
+  par::for_each_chunk(buckets, chunks, [&](auto i, par::Range range) {
+    auto out = data.begin() + slice_offsets[i];
+    for (auto k = range.begin; k < range.end; ++k) {
+      out = std::fill_n(out, totals[k], from_key(bounds, k));
+    }
+  });
+}
+
+// LSD radix sort on 8 bit digits of (value - min), skipping the digits
+// every key shares
+template <std::integral T>
+void radix(std::span<T> data, Bounds<T> bounds, std::size_t threads) {
+  constexpr auto digit_bits = 8U;
+  constexpr auto radix_size = 1UL << digit_bits;
+  const auto passes =
+      (std::bit_width(spread(bounds)) + digit_bits - 1) / digit_bits;
+  const auto chunks = par::chunk_count(data.size(), min_chunk, threads);
+
+  std::vector<T> buffer(data.size());
+  auto src = data;
+  auto dst = std::span<T>(buffer);
+
+  // counts[chunk][bucket], turned into that chunk's write offsets in place
+  std::vector<std::size_t> counts(chunks * radix_size);
+  for (auto pass = 0U; pass < passes; ++pass) {
+    const auto shift = pass * digit_bits;
+    const auto digit = [&](T value) {
+      return (to_key(bounds, value) >> shift) & (radix_size - 1);
+    };
+
+    std::fill(counts.begin(), counts.end(), 0);
+    par::for_each_chunk(src.size(), chunks, [&](auto i, par::Range range) {
+      auto *histogram = counts.data() + i * radix_size;
+      for (auto j = range.begin; j < range.end; ++j) {
+        ++histogram[digit(src[j])];
+      }
+    });
+
+    // bucket major, chunk minor keeps the sort stable
+    std::size_t offset = 0;
+    auto skip = false;
+    for (auto bucket = 0UL; bucket < radix_size; ++bucket) {
+      std::size_t bucket_size = 0;
+      for (auto c = 0UL; c < chunks; ++c) {
+        const auto count = counts[c * radix_size + bucket];
+        counts[c * radix_size + bucket] = offset + bucket_size;
+        bucket_size += count;
+      }
+      skip |= bucket_size == src.size();
+      offset += bucket_size;
+    }
+    if (skip) {
+      continue;
+    }
+
+    par::for_each_chunk(src.size(), chunks, [&](auto i, par::Range range) {
+      auto *offsets = counts.data() + i * radix_size;
+      for (auto j = range.begin; j < range.end; ++j) {
+        dst[offsets[digit(src[j])]++] = src[j];
+      }
+    });
+    std::swap(src, dst);
+  }
+
+  if (src.data() != data.data()) {
+    std::copy(src.begin(), src.end(), data.begin());
+  }
+}
+
+} // namespace detail
+
+// sorts with the given method regardless of what choose() would say, for
+// benchmarks and for callers that already know their data
+template <std::integral T>
+void sort_with(Method method, std::span<T> data, std::size_t threads = 1) {
+  if (data.size() < 2) {
+    return;
+  }
+  switch (method) {
+  case Method::Comparison:
+    std::sort(data.begin(), data.end());
+    return;
+  case Method::Counting:
+    detail::counting(data, bounds(std::span<const T>(data), threads),
+                     threads);
+    return;
+  case Method::Radix:
+    detail::radix(data, bounds(std::span<const T>(data), threads), threads);
+    return;
+  }
+}
+
+// returns the method it picked
+template <std::integral T>
+Method sort(std::span<T> data, std::size_t threads = 1) {
+  if (data.size() <= comparison_limit) {
+    std::sort(data.begin(), data.end());
+    return Method::Comparison;
+  }
+  const auto range = bounds(std::span<const T>(data), threads);
+  const auto method = choose(data.size(), range);
+  switch (method) {
+  case Method::Comparison:
+    std::sort(data.begin(), data.end());
+    break;
+  case Method::Counting:
+    detail::counting(data, range, threads);
+    break;
+  case Method::Radix:
+    detail::radix(data, range, threads);
+    break;
+  }
+  return method;
+}
+
+template <std::integral T>
+Method parallel_sort(std::span<T> data,
+                     std::size_t threads = par::hardware_threads()) {
+  return sort(data, threads);
+}
+
+} // namespace aoc::sort
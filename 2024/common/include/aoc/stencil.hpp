@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aoc/bitgrid.hpp"
+#include "aoc/grid.hpp"
+#include "aoc/parallel.hpp"
+
+// shape search on bit planes: a small 2D pattern with wildcards, e.g. the
+// X-MAS of day 4 as {"M.S", ".A.", "M.S"} with its rotations. every
+// orientation asked for is compiled to the list of its fixed cells, and a
+// shape anchored at (r, c) matches when every plane read at the cell's
+// offset has the bit set; one AND per fixed cell checks 64 anchors. the
+// planes are one BitGrid per letter the shape uses.
+namespace aoc::stencil {
+
+enum class Symmetry {
+  // the shape as given
+  None,
+  // and turned by 90, 180 and 270 degrees
+  Rotations,
+  // and each of those mirrored
+  All,
+};
+
+// one orientation of the shape, rows of equal width
+struct Variant {
+  std::vector<std::string> rows{};
+
+  std::size_t height() const { return rows.size(); }
+  std::size_t width() const { return rows.empty() ? 0 : rows[0].size(); }
+
+  bool operator==(const Variant &) const = default;
+
+  Variant rotated() const {
+    Variant turned{std::vector<std::string>(width(), std::string(height(), ' '))};
+    for (auto r = 0UL; r < height(); ++r) {
+      for (auto c = 0UL; c < width(); ++c) {
+        turned.rows[c][height() - 1 - r] = rows[r][c];
+      }
+    }
+    return turned;
+  }
+
+  Variant mirrored() const {
+    auto flipped = *this;
+    for (auto &row : flipped.rows) {
+      std::reverse(row.begin(), row.end());
+    }
+    return flipped;
+  }
+};
+
+struct Match {
+  // index into Matcher::variants()
+  std::size_t variant;
+  // where the variant's top left corner lies
+  std::size_t row;
+  std::size_t col;
+};
+
+struct Found {
+  std::size_t count = 0;
+  // only filled when asked for, in no particular order
+  std::vector<Match> matches{};
+};
+
+class Matcher {
+public:
+  // rows shorter than the widest are padded with the wildcard; orientations
+  // that come out the same are only searched once, so a symmetric shape is
+  // not counted twice on the same cells
+  explicit Matcher(std::span<const std::string_view> shape,
+                   Symmetry symmetry = Symmetry::None, char wildcard_ = '.')
+      : wildcard(wildcard_) {
+    std::size_t width = 0;
+    for (const auto row : shape) {
+      width = std::max(width, row.size());
+    }
+    Variant base{};
+    for (const auto row : shape) {
+      base.rows.emplace_back(row);
+      base.rows.back().resize(width, wildcard);
+    }
+
+    auto turned = base;
+    const auto turns = symmetry == Symmetry::None ? 1 : 4;
+    for (auto i = 0; i < turns; ++i, turned = turned.rotated()) {
+      add(turned);
+      if (symmetry == Symmetry::All) {
+        add(turned.mirrored());
+      }
+    }
+  }
+
+  const std::vector<Variant> &variants() const { return orientations; }
+
+  Found search(const Grid<char> &grid, bool positions = false,
+               std::size_t threads = par::hardware_threads()) const {
+    // one plane per letter used by any orientation, all from one pass
+    std::array<int, 256> plane_of{};
+    plane_of.fill(-1);
+    std::string letters{};
+    for (const auto &variant : compiled) {
+      for (const auto &cell : variant.cells) {
+        auto &k = plane_of[static_cast<unsigned char>(cell.letter)];
+        if (k < 0) {
+          k = static_cast<int>(letters.size());
+          letters.push_back(cell.letter);
+        }
+      }
+    }
+    const auto planes = BitGrid::equal(grid, letters, threads);
+
+    const auto words = (grid.cols() + 63) / 64;
+    const auto chunks = par::chunk_count(grid.rows(), 64, threads);
+    std::vector<Found> partial(chunks);
+    par::for_each_chunk(grid.rows(), chunks, [&](auto i, par::Range range) {
+      auto &found = partial[i];
+      for (auto v = 0UL; v < compiled.size(); ++v) {
+        const auto &variant = compiled[v];
+        if (variant.height > grid.rows() || variant.width > grid.cols()) {
+          continue;
+        }
+        // anchors the whole shape fits below and right of
+        const auto last_row = grid.rows() - variant.height;
+        const auto anchors = grid.cols() - variant.width + 1;
+        for (auto r = range.begin; r < std::min(range.end, last_row + 1); ++r) {
+          for (auto w = 0UL; w < words; ++w) {
+            auto hits = w * 64 + 64 <= anchors
+                            ? ~std::uint64_t{0}
+                            : (w * 64 < anchors
+                                   ? (std::uint64_t{1} << (anchors - w * 64)) - 1
+                                   : 0);
+            for (auto k = 0UL; k < variant.cells.size() && hits != 0; ++k) {
+              const auto &cell = variant.cells[k];
+              hits &= planes[static_cast<std::size_t>(
+                                 plane_of[static_cast<unsigned char>(
+                                     cell.letter)])]
+                          .word(static_cast<std::ptrdiff_t>(r) + cell.dr,
+                                static_cast<std::ptrdiff_t>(w * 64) + cell.dc);
+            }
+            found.count += static_cast<std::size_t>(std::popcount(hits));
+            for (; positions && hits != 0; hits &= hits - 1) {
+              found.matches.push_back(
+                  {v, r,
+                   w * 64 + static_cast<std::size_t>(std::countr_zero(hits))});
+            }
+          }
+        }
+      }
+    });
+
+    Found total{};
+    for (auto &k : partial) {
+      total.count += k.count;
+      total.matches.insert(total.matches.end(), k.matches.begin(),
+                           k.matches.end());
+    }
+    return total;
+  }
+
+private:
+  struct Cell {
+    std::ptrdiff_t dr;
+    std::ptrdiff_t dc;
+    char letter;
+  };
+
+  // the fixed cells of one orientation, the ops the search runs
+  struct Compiled {
+    std::size_t height;
+    std::size_t width;
+    std::vector<Cell> cells;
+  };
+
+  void add(const Variant &variant) {
+    if (std::find(orientations.begin(), orientations.end(), variant) !=
+        orientations.end()) {
+      return;
+    }
+    Compiled ops{variant.height(), variant.width(), {}};
+    for (auto r = 0UL; r < variant.height(); ++r) {
+      for (auto c = 0UL; c < variant.width(); ++c) {
+        if (variant.rows[r][c] != wildcard) {
+          ops.cells.push_back({static_cast<std::ptrdiff_t>(r),
+                               static_cast<std::ptrdiff_t>(c),
+                               variant.rows[r][c]});
+        }
+      }
+    }
+    orientations.push_back(variant);
+    compiled.push_back(std::move(ops));
+  }
+
+  char wildcard;
+  std::vector<Variant> orientations{};
+  std::vector<Compiled> compiled{};
+};
+
+} // namespace aoc::stencil
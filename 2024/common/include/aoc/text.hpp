@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "aoc/parallel.hpp"
+
+// whole-input and block-wise helpers for the solvers that parse in parallel
+namespace aoc::text {
+
+// "-" reads stdin, like aoc::pipe::read_lines
+inline std::string read_file(const std::string_view &file) {
+  if (file == "-") {
+    return {std::istreambuf_iterator<char>(std::cin),
+            std::istreambuf_iterator<char>()};
+  }
+  std::ifstream stream{std::string(file), std::ios::binary | std::ios::ate};
+  if (!stream.is_open()) {
+    throw std::system_error(
+        std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+  std::string content(static_cast<std::size_t>(stream.tellg()), '\0');
+  stream.seekg(0);
+  stream.read(content.data(), static_cast<std::streamsize>(content.size()));
+  return content;
+}
+
+// reads `stream` in blocks of about `block_size` bytes and calls fn(block)
+// with every block cut right after its last '\n', the partial line is
+// carried over into the next block; memory stays at one block whatever the
+// input size
+template <typename Fn>
+void for_each_block(std::istream &stream, std::size_t block_size, Fn fn) {
+  std::string block{};
+  std::size_t carry = 0;
+  while (stream) {
+    block.resize(std::max(block_size, carry * 2));
+    stream.read(block.data() + carry,
+                static_cast<std::streamsize>(block.size() - carry));
+    const auto filled = carry + static_cast<std::size_t>(stream.gcount());
+    const auto view = std::string_view(block).substr(0, filled);
+
+    const auto last = view.rfind('\n');
+    // a line longer than the block stays whole and makes the next one bigger
+    const auto end = !stream                           ? filled
+                     : last == std::string_view::npos ? 0
+                                                      : last + 1;
+    if (end > 0) {
+      fn(view.substr(0, end));
+    }
+    carry = filled - end;
+    std::copy(block.begin() + end, block.begin() + filled, block.begin());
+  }
+}
+
+inline void for_each_block(const std::string_view &file,
+                           std::size_t block_size, auto fn) {
+  if (file == "-") {
+    return for_each_block(std::cin, block_size, fn);
+  }
+  std::ifstream stream{std::string(file), std::ios::binary};
+  if (!stream.is_open()) {
+    throw std::system_error(
+        std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+  for_each_block(stream, block_size, fn);
+}
+
+// about `chunks` pieces of `text`, each ending right after a '\n' (or at the
+// end of the text) so no line is split between two of them
+inline std::vector<std::string_view> split_at_lines(std::string_view text,
+                                                    std::size_t chunks) {
+  std::vector<std::string_view> pieces{};
+  const auto target = text.size() / std::max<std::size_t>(chunks, 1) + 1;
+  while (!text.empty()) {
+    auto end = std::min(target, text.size());
+    end = std::min(text.find('\n', end - 1), text.size() - 1) + 1;
+    pieces.push_back(text.substr(0, end));
+    text.remove_prefix(end);
+  }
+  return pieces;
+}
+
+// for_each_block with the parsing spread over the threads: every block is
+// split at line boundaries into at most `threads` pieces of 1 MiB or more and
+// fn(slot, piece) runs on all of them at once. slots are below `threads` and
+// never shared by two running calls, so state kept per slot needs no lock
+template <typename Fn>
+void parse_blocks(const std::string_view &file, std::size_t threads, Fn fn) {
+  for_each_block(file, 1 << 24, [&](std::string_view block) {
+    const auto pieces = split_at_lines(
+        block, par::chunk_count(block.size(), 1 << 20, threads));
+    par::for_each_chunk(pieces.size(), pieces.size(),
+                        [&](auto slot, auto) { fn(slot, pieces[slot]); });
+  });
+}
+
+// the run-time counterparts of aoc::ct's helpers. unlike those they check
+// what they read: a number that is missing or too big throws
+
+// pops the next line off the front of `text`, without its "\n" or "\r\n"
+inline std::string_view next_line(std::string_view &text) {
+  const auto end = std::min(text.find('\n'), text.size());
+  auto line = text.substr(0, end);
+  text.remove_prefix(std::min(end + 1, text.size()));
+  if (line.ends_with('\r')) {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+// skips to the next run of digits in `text` and consumes it
+template <typename T> T next_uint(std::string_view &text) {
+  auto i = 0UL;
+  while (i < text.size() && (text[i] < '0' || text[i] > '9')) {
+    ++i;
+  }
+  T value{};
+  const auto [ptr, ec] =
+      std::from_chars(text.data() + i, text.data() + text.size(), value);
+  if (ec != std::errc()) {
+    throw std::system_error(std::make_error_code(ec));
+  }
+  text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+  return value;
+}
+
+} // namespace aoc::text
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "aoc/pipeline.hpp"
+#include "aoc/text.hpp"
+#include "online.hpp"
+
+template <typename... ArgsT>
+void print(const std::format_string<ArgsT...> fmt, ArgsT &&...args) {
+  std::cout << std::format(fmt, std::forward<ArgsT>(args)...) << std::endl;
+}
+
+// day1_online [file]
+//
+// reads location pairs from `file` (stdin by default) as they arrive, a
+// blank line closes a batch, and prints both answers after every batch
+int main(int argc, char **argv) {
+  const auto file = std::string_view(argc > 1 ? argv[1] : "-");
+
+  OnlineDay1 engine{};
+  auto batch = 0U;
+  auto pending = 0UL;
+  const auto report = [&] {
+    ++batch;
+    print("batch {}: {} pairs, distance {}, similarity {}", batch,
+          engine.size(), engine.distance(), engine.similarity());
+    pending = 0;
+  };
+
+  for (const auto &k : aoc::pipe::read_lines(file)) {
+    auto line = std::string_view(k);
+    if (line.empty() || line == "\r") {
+      if (pending != 0) {
+        report();
+      }
+      continue;
+    }
+    const auto left = aoc::text::next_uint<std::uint32_t>(line);
+    const auto right = aoc::text::next_uint<std::uint32_t>(line);
+    engine.add(left, right);
+    ++pending;
+  }
+  if (pending != 0 || batch == 0) {
+    report();
+  }
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aoc/flat_map.hpp"
+#include "similarity.hpp"
+
+// total distance of the sorted pairing, kept up to date as pairs arrive.
+//
+// with F_A(x) / F_B(x) the number of left / right ids <= x, the sorted
+// pairing costs sum over x of |D(x)| where D = F_A - F_B (pair i covers
+// every x between its two ids). appending (a, b) adds 1 to D on [a, b) or
+// subtracts 1 on [b, a), so the change in the total is the number of x in
+// that range where |D| grows minus where it shrinks. the id range is split
+// into sqrt(range) blocks that keep a lazy offset and a count of how many
+// of their D values sit at each level, which answers that in O(sqrt(range))
+// per pair. a truly logarithmic update is out of reach: inserting one pair
+// re-pairs every id ranked between a and b.
+class OnlineDistance {
+public:
+  explicit OnlineDistance(std::uint32_t max_id = (1 << 17) - 1)
+      : raw(std::size_t{max_id} + 1),
+        block_size(static_cast<std::uint32_t>(
+            std::ceil(std::sqrt(static_cast<double>(raw.size()))))) {
+    blocks.resize((raw.size() + block_size - 1) / block_size);
+    for (auto i = 0UL; i < blocks.size(); ++i) {
+      blocks[i].levels[0] = static_cast<std::uint32_t>(
+          std::min<std::size_t>(block_size, raw.size() - i * block_size));
+    }
+  }
+
+  void add(std::uint32_t left, std::uint32_t right) {
+    if (left >= raw.size() || right >= raw.size()) {
+      throw std::out_of_range("location id above " +
+                              std::to_string(raw.size() - 1));
+    }
+    if (left < right) {
+      shift(left, right, 1);
+    } else {
+      shift(right, left, -1);
+    }
+  }
+
+  std::uint64_t total() const { return sum; }
+
+private:
+  struct Block {
+    // D(x) = raw[x] + lazy for every x in the block
+    std::int64_t lazy = 0;
+    std::uint32_t negative = 0;
+    std::uint32_t positive = 0;
+    // raw value -> how many x in the block have it
+    aoc::FlatMap<std::int64_t, std::uint32_t> levels{};
+
+    std::uint32_t at_level(std::int64_t d) const {
+      const auto *count = levels.find(d - lazy);
+      return count == nullptr ? 0 : *count;
+    }
+  };
+
+  // D += delta on [begin, end)
+  void shift(std::uint32_t begin, std::uint32_t end, int delta) {
+    auto x = begin;
+    while (x < end) {
+      auto &block = blocks[x / block_size];
+      const auto block_begin = x / block_size * block_size;
+      const auto block_end = std::min<std::size_t>(block_begin + block_size,
+                                                   raw.size());
+      if (x == block_begin && end >= block_end) {
+        shift_block(block, block_end - block_begin, delta);
+        x = static_cast<std::uint32_t>(block_end);
+      } else {
+        shift_point(block, x, delta);
+        ++x;
+      }
+    }
+  }
+
+  // |D| grows by one wherever D already leans the way of delta (or is 0)
+  void shift_block(Block &block, std::size_t size, int delta) {
+    if (delta > 0) {
+      sum += size - 2 * block.negative;
+      block.negative -= block.at_level(-1);
+      block.positive += block.at_level(0);
+    } else {
+      sum += size - 2 * block.positive;
+      block.positive -= block.at_level(1);
+      block.negative += block.at_level(0);
+    }
+    block.lazy += delta;
+  }
+
+  void shift_point(Block &block, std::uint32_t x, int delta) {
+    const auto before = raw[x] + block.lazy;
+    const auto after = before + delta;
+    sum += static_cast<std::uint64_t>(std::abs(after) - std::abs(before));
+
+    --block.levels[raw[x]];
+    raw[x] += delta;
+    ++block.levels[raw[x]];
+
+    block.negative -= before < 0 ? 1 : 0;
+    block.positive -= before > 0 ? 1 : 0;
+    block.negative += after < 0 ? 1 : 0;
+    block.positive += after > 0 ? 1 : 0;
+  }
+
+  std::vector<std::int64_t> raw;
+  std::uint32_t block_size;
+  std::vector<Block> blocks{};
+  std::uint64_t sum = 0;
+};
+
+// both day 1 answers after every appended pair, without re-reading or
+// re-sorting anything
+class OnlineDay1 {
+public:
+  explicit OnlineDay1(std::uint32_t max_id = (1 << 17) - 1)
+      : sorted_distance(max_id), similarity_table(std::size_t{max_id} + 1) {}
+
+  void add(std::uint32_t left, std::uint32_t right) {
+    sorted_distance.add(left, right);
+    similarity_table.add_left(left);
+    similarity_table.add_right(right);
+  }
+
+  std::size_t size() const { return similarity_table.left_count(); }
+  std::uint64_t distance() const { return sorted_distance.total(); }
+  std::uint64_t similarity() const { return similarity_table.score(); }
+
+private:
+  OnlineDistance sorted_distance;
+  SimilarityTable similarity_table;
+};
@@ -1,123 +1,168 @@
 #include <algorithm>
-#include <cassert>
 #include <charconv>
 #include <format>
-#include <functional>
 #include <iostream>
+#include <limits>
 #include <string>
-#include <fstream>
 #include <ostream>
-#include <ranges>
 #include <utility>
 #include <vector>
-#include <numeric>
-#include <execution>
-#include <sstream>
+#include <optional>
+#include <span>
+
+#include "aoc/abs_diff.hpp"
+#include "aoc/cpu.hpp"
+#include "aoc/ct_parse.hpp"
+#include "aoc/external_sort.hpp"
+#include "aoc/parallel.hpp"
+#include "aoc/sort.hpp"
+#include "aoc/text.hpp"
+
+#ifdef AOC_EMBEDDED_INPUT
+#include <array>
+
+#include "aoc/embedded_input.hpp"
+
+// both columns are parsed and sorted by the compiler, nothing is left to do
+// at run time but print
+constexpr auto embedded_result = [] {
+    constexpr auto n = aoc::ct::count_lines(aoc::embedded_input);
+    std::array<int, n> l1{};
+    std::array<int, n> l2{};
+
+    auto rest = aoc::embedded_input;
+    for (auto i = 0UL; i < n; ++i) {
+        auto line = aoc::ct::next_line(rest);
+        l1[i] = aoc::ct::parse_uint<int>(line);
+        l2[i] = aoc::ct::parse_uint<int>(line);
+    }
+
+    std::sort(l1.begin(), l1.end());
+    std::sort(l2.begin(), l2.end());
 
-template <typename T, typename TIter, typename ...TArgs>
-T str_to(TIter iter_begin, TIter iter_end, TArgs&&... args){
-    T temp;
-    std::from_chars(iter_begin, iter_end, temp, std::forward<TArgs>(args)...);
-    return temp;
-} 
+    long result = 0;
+    for (auto i = 0UL; i < n; ++i) {
+        result += l1[i] > l2[i] ? l1[i] - l2[i] : l2[i] - l1[i];
+    }
+    return result;
+}();
+#endif
 
 template <typename... ArgsT>
 void print(const std::format_string<ArgsT...> fmt, ArgsT&&... args) {
     std::cout << std::format(fmt, std::forward<ArgsT>(args)...) << std::endl;
 }
 
-template <typename T, typename Functor>
-void print_vec(const std::vector<T>& vec, Functor to_str) {
-    const auto join_vec = [](const std::string& val1, const std::string& val2) -> std::string {
-        if (val1 != "") [[likely]] {
-            return std::format("{}, {}", val1, val2);
+// --memory-budget=<MiB> switches to the out of core mode; false when the
+// value is not a whole number of MiB that fits a size_t in bytes
+bool memory_budget(int argc, char** argv, std::optional<std::size_t>& budget){
+    constexpr auto flag = std::string_view("--memory-budget=");
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view(argv[i]);
+        if (!arg.starts_with(flag)) {
+            continue;
         }
-        else{
-            return val2;
+        const auto value = arg.substr(flag.size());
+        std::size_t mib = 0;
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), mib);
+        if (ec != std::errc() || ptr != value.data() + value.size() || mib == 0 ||
+            mib > (std::numeric_limits<std::size_t>::max() >> 20)) {
+            return false;
         }
-    };
-    const auto final = std::transform_reduce(vec.begin(), vec.end(), std::string(), join_vec, [&to_str](const T& val) -> std::string {return to_str(val);});
-    print("[{}]", final);
-}
-
-auto split_str(std::string_view str, std::string_view substr){    
-    auto splits = str | std::ranges::views::split( substr);
-
-    std::vector<int> result;
-
-    for(const auto& k: splits){
-        result.push_back(str_to<int>(k.begin(), k.end()));
+        budget = mib << 20;
     }
-
-    return result;
-}
-
-
-class Line : public std::string {};
-
-std::istream &operator>>(std::istream &is, Line &l)
-{
-    std::getline(is, l);
-    return is;
-
+    return true;
 }
 
-struct LineWrapper {
-    std::reference_wrapper<std::ifstream> ref;
-    LineWrapper(std::ifstream& stream_): ref(stream_) {};
-    auto begin(){ return std::istream_iterator<Line>(ref.get()); }
-    auto end(){ return  std::istream_iterator<Line>(); }
-};
-
-
-std::string read_file( std::ifstream& stream ){
-    std::ostringstream sstr;
-    sstr << stream.rdbuf();
-    return sstr.str();
-}
-
-auto get_lines(std::ifstream& stream){
-    return LineWrapper(stream);
+// for inputs bigger than RAM: each column is sorted in runs that fit half
+// the budget, spilled to temporary files and k-way merged back, both columns
+// in lockstep so the differences are summed as the values stream out
+std::uint64_t external_distance(std::string_view file, std::size_t budget){
+    aoc::ExternalSorter<int> l1{budget / 2};
+    aoc::ExternalSorter<int> l2{budget / 2};
+
+    aoc::text::for_each_block(file, std::min<std::size_t>(1 << 20, budget / 4 + 1), [&](std::string_view block) {
+        while (!block.empty()) {
+            auto line = aoc::text::next_line(block);
+            if (!line.empty()) {
+                l1.push(aoc::text::next_uint<int>(line));
+                l2.push(aoc::text::next_uint<int>(line));
+            }
+        }
+    });
+
+    l1.finish();
+    l2.finish();
+    print("l1 has {} and l2 has {}, sorted in {} + {} runs", l1.size(), l2.size(), l1.run_count(), l2.run_count());
+
+    // merged values are gathered in small batches for the SIMD kernel
+    std::vector<int> batch1(4096);
+    std::vector<int> batch2(4096);
+    std::uint64_t res = 0;
+    for (auto n = batch1.size(); n == batch1.size();) {
+        n = 0;
+        while (n < batch1.size() && l1.next(batch1[n]) && l2.next(batch2[n])) {
+            ++n;
+        }
+        res += aoc::kernels::sum_abs_diff(std::span(batch1.data(), n), std::span(batch2.data(), n));
+    }
+    return res;
 }
 
-template<typename T>
-void print_vec(const std::vector<T>& vec){
-    return print_vec(vec,[](const T& val){ return std::to_string(val); });
-}
 int main(int argc, char** argv){
 	std::cout << "Hello World" << std::endl;
+    aoc::cpu::init(argc, argv);
+
+#ifdef AOC_EMBEDDED_INPUT
+    print("result: {}", embedded_result);
+#else
+    std::optional<std::size_t> budget{};
+    if (!memory_budget(argc, argv, budget)) {
+        std::cerr << "usage: " << argv[0] << " [--memory-budget=<MiB>] [--force-isa=<isa>]" << std::endl;
+        return 2;
+    }
+    if (budget) {
+        print("result: {}", external_distance("input", *budget));
+        return 0;
+    }
 
-    std::ifstream myfile{};
-    myfile.open("input");
-
-    std::string line;
-    std::vector<int> l1;
-    std::vector<int> l2;
-
-    if (myfile.is_open()) {
-        for (auto& k: get_lines(myfile)){
-            print("{}", k.c_str());
-            auto vec = split_str(line.c_str(), "   ");
-            print_vec(vec);
-            assert(vec.size() == 2);
-            l1.push_back(vec[0]);
-            l2.push_back(vec[1]);            
+    // every thread parses its pieces into columns of its own, joined once the
+    // whole file is read; the order does not matter, both get sorted anyway
+    const auto threads = aoc::par::hardware_threads();
+    std::vector<std::vector<int>> parts1(threads);
+    std::vector<std::vector<int>> parts2(threads);
+    aoc::text::parse_blocks("input", threads, [&](auto slot, std::string_view piece) {
+        while (!piece.empty()) {
+            auto line = aoc::text::next_line(piece);
+            if (line.empty()) {
+                continue;
+            }
+            parts1[slot].push_back(aoc::text::next_uint<int>(line));
+            parts2[slot].push_back(aoc::text::next_uint<int>(line));
         }
+    });
+
+    auto l1 = std::move(parts1[0]);
+    auto l2 = std::move(parts2[0]);
+    for (auto i = 1UL; i < threads; ++i) {
+        l1.insert(l1.end(), parts1[i].begin(), parts1[i].end());
+        l2.insert(l2.end(), parts2[i].begin(), parts2[i].end());
+        parts1[i] = {};
+        parts2[i] = {};
+    }
 
-        myfile.close();
-
-        std::sort(l1.begin(), l1.end());
-        std::sort(l2.begin(), l2.end());
-        print_vec(l1, [](int a){return std::to_string(a); });
-        print("l1 has {} and l2 has {}", l1.size(), l2.size());
+    const auto method = aoc::sort::parallel_sort(std::span<int>(l1));
+    aoc::sort::parallel_sort(std::span<int>(l2));
+    print("sorted with {} sort", aoc::sort::to_string(method));
+    print("l1 has {} and l2 has {}", l1.size(), l2.size());
 
-        const auto res = std::transform_reduce(l1.begin(), l1.end(), l2.begin(), 
-            0,
-            std::plus<>(), // sum everything
-            [](const auto& v1,const auto& v2){return abs(v1 - v2);}); // transform: calc value diff between both vecs
+    // 64 bit total, vectorised and split over the threads
+    const auto res = aoc::kernels::parallel_sum_abs_diff(l1, l2);
+    print("summed differences with {}", aoc::cpu::to_string(
+        aoc::kernels::sum_abs_diff_kernel.resolved_isa()));
 
-        print("result: {}", res);
-    }
+    print("result: {}", res);
+#endif
     
 	return 0;
 }
\ No newline at end of file
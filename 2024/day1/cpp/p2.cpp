@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <format>
 #include <functional>
 #include <iostream>
@@ -11,79 +12,80 @@
 #include <numeric>
 #include <execution>
 
-template <typename T>
-std::string to_str(T a){ return std::to_string(a); }
-template <typename T, typename TIter, typename ...TArgs>
-T str_to(TIter iter_begin, TIter iter_end, TArgs&&... args){
-    T temp{};
-    std::from_chars(iter_begin, iter_end, temp, std::forward<TArgs>(args)...);
-    return temp;
-} 
+#include "aoc/ct_parse.hpp"
+#include "aoc/parallel.hpp"
+#include "aoc/text.hpp"
+#include "similarity.hpp"
 
-template <typename... ArgsT>
-void print(const std::format_string<ArgsT...> fmt, ArgsT&&... args) {
-    std::cout << std::format(fmt, std::forward<ArgsT>(args)...) << std::endl;
-}
+#ifdef AOC_EMBEDDED_INPUT
+#include <array>
 
-template <typename T, typename Functor>
-void print_vec(const std::vector<T>& vec, Functor to_str) {
-    const auto join_vec = [](const std::string& val1, const std::string& val2) -> std::string {
-        if (val1 != "") [[likely]] {
-            return std::format("{}, {}", val1, val2);
-        }
-        else{
-            return val2;
-        }
-    };
-    const auto final = std::transform_reduce(vec.begin(), vec.end(), std::string(), join_vec, [&to_str](const T& val) -> std::string {return to_str(val);});
-    print("[{}]", final);
-}
+#include "aoc/embedded_input.hpp"
+
+// parsed, sorted and matched up by the compiler: walking both sorted columns
+// side by side gives every count without the quadratic std::count
+constexpr auto embedded_result = [] {
+    constexpr auto n = aoc::ct::count_lines(aoc::embedded_input);
+    std::array<long, n> l1{};
+    std::array<long, n> l2{};
 
-auto split_str(std::string_view str, std::string_view substr){    
-    auto splits = str | std::ranges::views::split( substr);
+    auto rest = aoc::embedded_input;
+    for (auto i = 0UL; i < n; ++i) {
+        auto line = aoc::ct::next_line(rest);
+        l1[i] = aoc::ct::parse_uint<long>(line);
+        l2[i] = aoc::ct::parse_uint<long>(line);
+    }
 
-    std::vector<int> result;
+    std::sort(l1.begin(), l1.end());
+    std::sort(l2.begin(), l2.end());
 
-    for(const auto& k: splits){
-        result.push_back(str_to<long>(k.begin(), k.end()));
+    long result = 0;
+    auto j = 0UL;
+    for (auto i = 0UL; i < n; ++i) {
+        while (j < n && l2[j] < l1[i]) {
+            ++j;
+        }
+        for (auto k = j; k < n && l2[k] == l1[i]; ++k) {
+            result += l1[i];
+        }
     }
-    print("origin {}", str);
-    print_vec(result, to_str<int>);
     return result;
+}();
+#endif
+
+template <typename... ArgsT>
+void print(const std::format_string<ArgsT...> fmt, ArgsT&&... args) {
+    std::cout << std::format(fmt, std::forward<ArgsT>(args)...) << std::endl;
 }
 
-int main(int argc, char** argv){
+int main(){
 	std::cout << "Hello World" << std::endl;
 
-    std::ifstream myfile{};
-    myfile.open("input");
-
-    std::string line;
-
-
-    std::vector<int> l1;
-    std::vector<int> l2;  
-    std::cout << "Before hell" << std::endl;
-    if (myfile.is_open()) {
-        while (std::getline(myfile, line)) {
-            auto vec = split_str(line, "  ");
-            assert(vec.size() == 2);
-            l1.push_back(vec[0]);
-            l2.push_back(vec[1]);
+#ifdef AOC_EMBEDDED_INPUT
+    print("result: {}", embedded_result);
+#else
+    // one streaming pass, the lists are never stored: every thread keeps its
+    // own table across blocks and the tables are merged at the end
+    const auto threads = aoc::par::hardware_threads();
+    std::vector<SimilarityTable> tables(threads);
+    aoc::text::parse_blocks("input", threads, [&](auto slot, std::string_view piece) {
+        while (!piece.empty()) {
+            auto line = aoc::text::next_line(piece);
+            if (line.empty()) {
+                continue;
+            }
+            tables[slot].add_left(aoc::text::next_uint<std::uint64_t>(line));
+            tables[slot].add_right(aoc::text::next_uint<std::uint64_t>(line));
         }
+    });
 
-        myfile.close();
-
-        std::sort(l1.begin(), l1.end());
-        std::sort(l2.begin(), l2.end());
-        //print_vec(l1, [](int a){return std::to_string(a); });
-        //print_vec(l2, [](int a){return std::to_string(a); });
-        print("l1 has {} and l2 has {}", l1.size(), l2.size());
-
-        const auto res = std::transform_reduce(l1.begin(), l1.end(), 0, std::plus<>(), [&l2](const auto& v1){return v1 * std::count(l2.begin(), l2.end(), v1);});
-
-        print("result: {}", res);
+    SimilarityTable res{};
+    for (const auto& k: tables) {
+        res.merge(k);
     }
+    print("l1 has {} and l2 has {}", res.left_count(), res.right_count());
+    print("result: {}", res.score());
+#endif
     
 	return 0;
 }
\ No newline at end of file
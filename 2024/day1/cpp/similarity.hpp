@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "aoc/flat_map.hpp"
+
+// similarity score = sum over every id of id * (times in the left list) *
+// (times in the right list). both counts live in one table and the score is
+// kept up to date as ids come in, so the lists never need to be stored or
+// sorted. ids are counted in a flat array sized from the largest id seen so
+// far (it doubles as bigger ids come in); ids past `dense_limit` would make
+// it too big and go to a hash map instead.
+class SimilarityTable {
+public:
+  // 2^20 ids of two counters is 16 MiB per table
+  static constexpr std::size_t default_dense_limit = 1 << 20;
+
+  explicit SimilarityTable(std::size_t dense_limit_ = default_dense_limit)
+      : dense_limit(dense_limit_) {}
+
+  void add_left(std::uint64_t id) {
+    auto &counts = at(id);
+    total += id * counts.right;
+    ++counts.left;
+    ++left_size;
+  }
+
+  void add_right(std::uint64_t id) {
+    auto &counts = at(id);
+    total += id * counts.left;
+    ++counts.right;
+    ++right_size;
+  }
+
+  // tables built over disjoint parts of the input add up to the table of
+  // the whole input: only the cross terms left x right' and left' x right
+  // are new
+  void merge(const SimilarityTable &other) {
+    const auto add = [this](std::uint64_t id, const Counts &theirs) {
+      auto &ours = at(id);
+      total += id * (ours.left * theirs.right + theirs.left * ours.right);
+      ours.left += theirs.left;
+      ours.right += theirs.right;
+    };
+    for (auto id = 0UL; id < other.dense.size(); ++id) {
+      if (other.dense[id].left != 0 || other.dense[id].right != 0) {
+        add(id, other.dense[id]);
+      }
+    }
+    other.sparse.for_each(add);
+    total += other.total;
+    left_size += other.left_size;
+    right_size += other.right_size;
+  }
+
+  std::uint64_t score() const { return total; }
+  std::size_t left_count() const { return left_size; }
+  std::size_t right_count() const { return right_size; }
+
+private:
+  struct Counts {
+    std::uint64_t left = 0;
+    std::uint64_t right = 0;
+  };
+
+  Counts &at(std::uint64_t id) {
+    if (id < dense.size()) {
+      return dense[id];
+    }
+    if (id >= dense_limit) {
+      return sparse[id];
+    }
+    // never past the limit, an id lives in one of the two for good
+    dense.resize(std::min(
+        std::max<std::size_t>(std::bit_ceil(static_cast<std::size_t>(id) + 1),
+                              1024),
+        dense_limit));
+    return dense[id];
+  }
+
+  std::size_t dense_limit;
+  std::vector<Counts> dense{};
+  aoc::FlatMap<std::uint64_t, Counts> sparse{};
+  std::uint64_t total = 0;
+  std::size_t left_size = 0;
+  std::size_t right_size = 0;
+};
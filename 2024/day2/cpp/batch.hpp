@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "aoc/cpu.hpp"
+#include "report.hpp"
+
+#if AOC_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// strict safety of many short reports at once. reports are transposed into
+// columns (level j of every report next to each other) so one vector
+// compare checks step j of 8 (AVX2) or 16 (AVX-512) reports. levels past
+// the end of a report are a sentinel that passes every check; reports
+// longer than max_levels are checked by the scalar scan instead.
+namespace report {
+
+inline constexpr std::size_t max_levels = 8;
+inline constexpr int sentinel = INT_MIN;
+
+// safe[r] = report r (levels at columns[j * stride + r]) is strictly safe;
+// vector variants expect `count` to be a multiple of their width
+using BatchFn = void(const int *, std::size_t, std::size_t, std::uint8_t *);
+
+namespace detail {
+
+inline void batch_safe_scalar(const int *columns, std::size_t stride,
+                              std::size_t count, std::uint8_t *safe) {
+  for (auto r = 0UL; r < count; ++r) {
+    auto increasing = true;
+    auto decreasing = true;
+    for (auto j = 1UL; j < max_levels; ++j) {
+      const auto level = columns[j * stride + r];
+      if (level == sentinel) {
+        break;
+      }
+      const auto previous = columns[(j - 1) * stride + r];
+      increasing &= is_safe_step(previous, level, 1);
+      decreasing &= is_safe_step(previous, level, -1);
+    }
+    safe[r] = increasing || decreasing;
+  }
+}
+
+#if AOC_X86_DISPATCH
+AOC_TARGET_AVX2 inline void batch_safe_avx2(const int *columns,
+                                            std::size_t stride,
+                                            std::size_t count,
+                                            std::uint8_t *safe) {
+  const auto end = _mm256_set1_epi32(sentinel);
+  const auto zero = _mm256_setzero_si256();
+  const auto four = _mm256_set1_epi32(4);
+  const auto minus_four = _mm256_set1_epi32(-4);
+  for (auto r = 0UL; r < count; r += 8) {
+    auto increasing = _mm256_set1_epi32(-1);
+    auto decreasing = _mm256_set1_epi32(-1);
+    auto previous = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(columns + r));
+    for (auto j = 1UL; j < max_levels; ++j) {
+      const auto level = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(columns + j * stride + r));
+      const auto padding = _mm256_cmpeq_epi32(level, end);
+      const auto step = _mm256_sub_epi32(level, previous);
+      const auto up = _mm256_and_si256(_mm256_cmpgt_epi32(step, zero),
+                                       _mm256_cmpgt_epi32(four, step));
+      const auto down = _mm256_and_si256(_mm256_cmpgt_epi32(zero, step),
+                                         _mm256_cmpgt_epi32(step, minus_four));
+      increasing = _mm256_and_si256(increasing, _mm256_or_si256(up, padding));
+      decreasing =
+          _mm256_and_si256(decreasing, _mm256_or_si256(down, padding));
+      previous = level;
+    }
+    const auto mask = static_cast<unsigned>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_or_si256(increasing, decreasing))));
+    for (auto lane = 0U; lane < 8; ++lane) {
+      safe[r + lane] = (mask >> lane) & 1U;
+    }
+  }
+}
+
+AOC_TARGET_AVX512BW inline void batch_safe_avx512bw(const int *columns,
+                                                    std::size_t stride,
+                                                    std::size_t count,
+                                                    std::uint8_t *safe) {
+  const auto end = _mm512_set1_epi32(sentinel);
+  const auto one = _mm512_set1_epi32(1);
+  const auto three = _mm512_set1_epi32(3);
+  const auto minus_one = _mm512_set1_epi32(-1);
+  const auto minus_three = _mm512_set1_epi32(-3);
+  for (auto r = 0UL; r < count; r += 16) {
+    __mmask16 increasing = 0xffff;
+    __mmask16 decreasing = 0xffff;
+    auto previous = _mm512_loadu_si512(columns + r);
+    for (auto j = 1UL; j < max_levels; ++j) {
+      const auto level = _mm512_loadu_si512(columns + j * stride + r);
+      const auto padding = _mm512_cmpeq_epi32_mask(level, end);
+      const auto step = _mm512_sub_epi32(level, previous);
+      const auto up = _mm512_cmpge_epi32_mask(step, one) &
+                      _mm512_cmple_epi32_mask(step, three);
+      const auto down = _mm512_cmple_epi32_mask(step, minus_one) &
+                        _mm512_cmpge_epi32_mask(step, minus_three);
+      increasing &= up | padding;
+      decreasing &= down | padding;
+      previous = level;
+    }
+    // one byte per lane straight from the mask
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(safe + r),
+                     _mm_maskz_set1_epi8(increasing | decreasing, 1));
+  }
+}
+#endif
+
+} // namespace detail
+
+#if AOC_X86_DISPATCH
+inline constexpr aoc::cpu::Kernel<BatchFn> batch_safe_kernel{
+    detail::batch_safe_scalar, nullptr, detail::batch_safe_avx2,
+    detail::batch_safe_avx512bw};
+#else
+inline constexpr aoc::cpu::Kernel<BatchFn> batch_safe_kernel{
+    detail::batch_safe_scalar};
+#endif
+
+// collects reports until full, flush() classifies them all and hands every
+// report back in order with its strict verdict, so callers only run the
+// dampener (or anything else scalar) on the ones that failed
+class Batch {
+public:
+  static constexpr std::size_t lanes = 16;
+
+  explicit Batch(std::size_t capacity_ = 4096)
+      : capacity((capacity_ + lanes - 1) / lanes * lanes),
+        columns(max_levels * capacity), safe(capacity) {
+    offsets.reserve(capacity + 1);
+    offsets.push_back(0);
+  }
+
+  bool full() const { return size() == capacity; }
+  std::size_t size() const { return offsets.size() - 1; }
+
+  void add(std::span<const int> report) {
+    const auto r = size();
+    for (auto j = 0UL; j < max_levels; ++j) {
+      columns[j * capacity + r] = j < report.size() ? report[j] : sentinel;
+    }
+    levels.insert(levels.end(), report.begin(), report.end());
+    offsets.push_back(levels.size());
+  }
+
+  // visit(levels, strictly_safe) for every report added since the last flush
+  template <typename Visitor> void flush(Visitor visit) {
+    const auto count = size();
+    const auto padded = (count + lanes - 1) / lanes * lanes;
+    for (auto r = count; r < padded; ++r) {
+      for (auto j = 0UL; j < max_levels; ++j) {
+        columns[j * capacity + r] = sentinel;
+      }
+    }
+    kernel(columns.data(), capacity, padded, safe.data());
+
+    for (auto r = 0UL; r < count; ++r) {
+      const auto report = std::span<const int>(levels).subspan(
+          offsets[r], offsets[r + 1] - offsets[r]);
+      // too long for the columns, or holding the sentinel value itself
+      const auto fits = report.size() <= max_levels &&
+                        std::find(report.begin(), report.end(), sentinel) ==
+                            report.end();
+      visit(report, fits ? safe[r] != 0 : is_safe(report));
+    }
+
+    levels.clear();
+    offsets.resize(1);
+  }
+
+private:
+  // bound once, flush() runs for every few thousand reports
+  BatchFn *kernel = batch_safe_kernel.bind();
+  std::size_t capacity;
+  std::vector<int> columns;
+  std::vector<std::uint8_t> safe;
+  // the reports as given, for the scalar fallbacks
+  std::vector<int> levels{};
+  std::vector<std::size_t> offsets{};
+};
+
+} // namespace report
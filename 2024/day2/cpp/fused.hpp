@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "aoc/parallel.hpp"
+#include "aoc/text.hpp"
+#include "report.hpp"
+
+// parse and check in one go: the bytes of each report feed report::Scan as
+// every number is decoded, the levels are never stored, so memory stays
+// constant and the speed is bound by reading the input. blocks of the file
+// are split at line boundaries between the threads.
+namespace report {
+
+struct Tally {
+  std::size_t reports = 0;
+  std::size_t safe = 0;
+  std::size_t safe_dampened = 0;
+
+  constexpr Tally &operator+=(const Tally &other) {
+    reports += other.reports;
+    safe += other.safe;
+    safe_dampened += other.safe_dampened;
+    return *this;
+  }
+};
+
+// whole lines of space separated levels; blank lines are not reports
+constexpr Tally check_reports(std::string_view text) {
+  Tally tally{};
+  Scan scan{};
+  int level = 0;
+  bool in_number = false;
+  bool negative = false;
+
+  const auto end_report = [&] {
+    if (scan.size() != 0) {
+      ++tally.reports;
+      tally.safe += scan.safe() ? 1 : 0;
+      tally.safe_dampened += scan.safe_dampened() ? 1 : 0;
+    }
+    scan = Scan{};
+  };
+
+  for (const auto c : text) {
+    if (c >= '0' && c <= '9') {
+      level = level * 10 + (c - '0');
+      in_number = true;
+      continue;
+    }
+    if (in_number) {
+      scan.push(negative ? -level : level);
+      level = 0;
+      in_number = false;
+    }
+    negative = c == '-';
+    if (c == '\n') {
+      end_report();
+    }
+  }
+  if (in_number) {
+    scan.push(negative ? -level : level);
+  }
+  end_report();
+  return tally;
+}
+
+inline Tally check_file(std::string_view file,
+                        std::size_t threads = aoc::par::hardware_threads()) {
+  std::vector<Tally> partial(threads);
+  aoc::text::parse_blocks(file, threads,
+                          [&](auto slot, std::string_view piece) {
+                            partial[slot] += check_reports(piece);
+                          });
+  Tally total{};
+  for (const auto &k : partial) {
+    total += k;
+  }
+  return total;
+}
+
+} // namespace report
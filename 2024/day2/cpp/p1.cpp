@@ -10,12 +10,20 @@
 #include <iterator>
 #include <ostream>
 #include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <numeric>
 #include <execution>
 
+#include "aoc/cpu.hpp"
+#include "aoc/pipeline.hpp"
+#include "batch.hpp"
+#include "fused.hpp"
+#include "report.hpp"
+
 template <typename T, typename TIter, typename ...TArgs>
 T str_to(TIter iter_begin, TIter iter_end, TArgs&&... args){
     T temp;
@@ -60,41 +68,43 @@ auto split_str(std::string_view str, std::string_view substr){
 }
 int main(int argc, char** argv){
 	std::cout << "Hello World" << std::endl;
+    aoc::cpu::init(argc, argv);
 
-    std::ifstream myfile{};
-    myfile.open("input");
+    // --fused: parse and check straight from the bytes on every core
+    if (std::find(argv + 1, argv + argc, std::string_view("--fused")) != argv + argc) {
+        print("result: {}", report::check_file("input").safe);
+        return 0;
+    }
 
-    std::string line;
-    
     unsigned int safe_report = 0;
 
-    if (myfile.is_open()) {
-        while (std::getline(myfile, line)) {
-            auto levels = split_str(line, " ");
-
-            // get adjacent differences
-            std::vector<int> adjacent_difference;
-            std::adjacent_difference(levels.begin(), levels.end(), std::back_inserter(adjacent_difference));
-
-            print_vec(adjacent_difference);
-            // get sign of first value
-            const auto sign_bit = std::signbit(*next(adjacent_difference.begin()));
-            const auto is_safe = std::all_of(next(adjacent_difference.begin()), adjacent_difference.end(), [sign_bit](const int& val) -> bool {
-                auto abs_val = std::abs(val);
-
-                // same sign and value between 1 and 3
-                return (std::signbit(val) == sign_bit && abs_val >= 1 && abs_val <= 3);
-            });
+    // reports are independent, so parse them on a producer thread and never
+    // hold more than a small window of the input in memory
+    auto reports = aoc::pipe::read_lines("input")
+        | aoc::pipe::transform([](const std::string& line){ return split_str(line, " "); })
+        | aoc::pipe::buffered(256);
+
+    // checked a few thousand at a time, 8 or 16 reports per vector compare
+    report::Batch batch{};
+    const auto count_safe = [&safe_report](std::span<const int>, bool is_safe) {
+        if (is_safe){
+            ++safe_report;
+        }
+    };
 
-            if (is_safe){
-                ++safe_report;
-            }
+    for (const auto& levels: reports) {
+        // blank lines are not reports, as in --fused
+        if (levels.empty()) {
+            continue;
+        }
+        batch.add(levels);
+        if (batch.full()) {
+            batch.flush(count_safe);
         }
+    }
+    batch.flush(count_safe);
 
-        myfile.close();
+    print("result: {}", safe_report);
 
-        print("result: {}", safe_report);
-    }
-    
 	return 0;
 }
\ No newline at end of file
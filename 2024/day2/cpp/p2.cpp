@@ -10,13 +10,22 @@
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "aoc/cpu.hpp"
+#include "aoc/pipeline.hpp"
+#include "batch.hpp"
+#include "fused.hpp"
+#include "report.hpp"
+
 template <typename T, typename TIter, typename ...TArgs>
 T str_to(TIter iter_begin, TIter iter_end, TArgs&&... args){
     T temp;
@@ -60,58 +69,6 @@ auto split_str(std::string_view str, std::string_view substr){
     return result;
 }
 
-template <typename T>
-std::vector<T> remove_at(const std::vector<T>& vec, unsigned long at){
-    auto pruned_vec = std::vector<int>(vec);
-    pruned_vec.erase(std::next(pruned_vec.begin(), std::clamp(at, 0UL, pruned_vec.size())));
-    return pruned_vec;
-}
-
-bool is_safe(const auto& levels, bool found_bad_level_already = false){
-    // get adjacent differences
-    std::vector<int> adjacent_difference;
-    std::adjacent_difference(levels.begin(), levels.end(), std::back_inserter(adjacent_difference));
-    adjacent_difference.erase(adjacent_difference.begin());
-
-    std::vector<bool> adj_dif_values;
-    std::transform(adjacent_difference.begin(), adjacent_difference.end(), std::back_inserter(adj_dif_values), [](const int& val) -> bool {
-        auto abs_val = std::abs(val);
-        return abs_val >= 1 && abs_val <= 3;
-    });
-
-    std::vector<bool> swapped_sign;
-    std::adjacent_difference(adjacent_difference.begin(), adjacent_difference.end(), std::back_inserter(swapped_sign), [](const int& valA, const int& valB) -> bool {
-        return std::signbit(valA) == std::signbit(valB);
-    });
-
-    std::vector<bool> combined;
-    std::transform(adj_dif_values.begin(), adj_dif_values.end(), swapped_sign.begin(), std::back_inserter(combined), [](bool a, bool b){return a && b;});
-
-    // i am lazy so i will try the following
-    //print("Got level");
-    //print_vec(levels);
-    //print_vec(adj_dif_values);
-    //print_vec(swapped_sign);
-    //print_vec(combined);
-
-    // found adj value diff
-    if (auto iter = std::find(combined.begin(), combined.end(), false); iter != combined.end()){
-        if (found_bad_level_already){
-            return false;
-        }
-        auto dist = std::clamp(static_cast<unsigned long>(std::distance(combined.begin(), iter)), 0UL, levels.size());
-        
-        // check surrounding vectors
-        return is_safe(remove_at(levels, dist-1), true) || 
-            is_safe(remove_at(levels, dist), true) || 
-            is_safe(remove_at(levels, dist+1), true);
-    }
-    
-    
-
-    return true;
-}
-
 class Line : public std::string {};
 
 std::istream &operator>>(std::istream &is, Line &l) {
@@ -132,31 +89,99 @@ std::string read_file(std::ifstream &stream) {
   return sstr.str();
 }
 
+// --max-removals=<k> tolerates k bad levels instead of the dampener's one;
+// nullopt when k is not a number
+std::optional<std::size_t> max_removals(int argc, char** argv){
+    constexpr auto flag = std::string_view("--max-removals=");
+    std::size_t tolerated = 1;
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view(argv[i]);
+        if (!arg.starts_with(flag)) {
+            continue;
+        }
+        const auto value = arg.substr(flag.size());
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), tolerated);
+        if (ec != std::errc() || ptr != value.data() + value.size()) {
+            return std::nullopt;
+        }
+    }
+    return tolerated;
+}
+
 int main(int argc, char** argv){
 	std::cout << "Hello World" << std::endl;
+    aoc::cpu::init(argc, argv);
 
-    std::ifstream myfile{};
-    myfile.open("input");
+    const auto parsed = max_removals(argc, argv);
+    if (!parsed) {
+        std::cerr << "usage: " << argv[0] << " [--max-removals=<k>] [--fused] [--force-isa=<isa>]" << std::endl;
+        return 2;
+    }
+    const auto tolerated = *parsed;
+    // --fused: parse and check straight from the bytes on every core, the
+    // levels are never stored so only the one level dampener is available
+    if (std::find(argv + 1, argv + argc, std::string_view("--fused")) != argv + argc) {
+        if (tolerated != 1) {
+            std::cerr << "--fused only supports --max-removals=1" << std::endl;
+            return 2;
+        }
+        print("result: {}", report::check_file("input").safe_dampened);
+        return 0;
+    }
 
-    std::string line;
-    
     unsigned int safe_report = 0;
     unsigned int line_number = 0;
+    // distribution[r]: reports that need exactly r removals, grown as they
+    // come since k can be anything; no report of n levels needs more than
+    // n - 1, so the table stays as small as the longest report
+    std::vector<unsigned int> distribution{};
+    unsigned int too_many = 0;
+    std::size_t longest = 0;
+
+    auto reports = aoc::pipe::read_lines("input")
+        | aoc::pipe::transform([](const std::string& line){ return split_str(line, " "); })
+        | aoc::pipe::buffered(256);
+
+    // strictly safe reports are sorted out in vector batches, only the
+    // rest go through the scalar dp
+    report::Batch batch{};
+    const auto check = [&](std::span<const int> levels, bool strictly_safe) {
+      ++line_number;
+      longest = std::max(longest, levels.size());
+      const auto removals =
+          strictly_safe ? 0
+                        : report::min_removals(
+                              levels, std::min(tolerated, levels.size()));
+      if (removals > tolerated) {
+        ++too_many;
+        return;
+      }
+      if (removals >= distribution.size()) {
+        distribution.resize(removals + 1);
+      }
+      ++distribution[removals];
+      print("{}", line_number);
+      ++safe_report;
+    };
 
-    if (myfile.is_open()) {
-        while (std::getline(myfile, line)) {
-          ++line_number;
-          auto levels = split_str(line, " ");
-          if (is_safe(levels)) {
-            print("{}", line_number);
-            ++safe_report;
-          }
-        }
-
-        myfile.close();
+    for (const auto& levels: reports) {
+      // blank lines are not reports, as in --fused
+      if (levels.empty()) {
+        continue;
+      }
+      batch.add(levels);
+      if (batch.full()) {
+        batch.flush(check);
+      }
+    }
+    batch.flush(check);
 
-        print("result: {}", safe_report);
+    distribution.resize(std::max(distribution.size(), std::min(tolerated, longest) + 1));
+    for (auto r = 0UL; r < distribution.size(); ++r) {
+      print("{} removals: {} reports", r, distribution[r]);
     }
-    
+    print("more than {} removals: {} reports", tolerated, too_many);
+    print("result: {}", safe_report);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+// frozen copy of ../p2.cpp, tools/verify checks the optimised solver
+// against it. keep it slow and obvious, only fix bugs
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <execution>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <ostream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aoc/pipeline.hpp"
+
+template <typename T, typename TIter, typename ...TArgs>
+T str_to(TIter iter_begin, TIter iter_end, TArgs&&... args){
+    T temp;
+    std::from_chars(iter_begin, iter_end, temp, std::forward<TArgs>(args)...);
+    return temp;
+} 
+
+template <typename... ArgsT>
+void print(const std::format_string<ArgsT...> fmt, ArgsT&&... args) {
+    std::cout << std::format(fmt, std::forward<ArgsT>(args)...) << std::endl;
+}
+
+template <typename T, typename Functor>
+void print_vec(const std::vector<T>& vec, Functor to_str) {
+    const auto join_vec = [](const std::string& val1, const std::string& val2) -> std::string {
+        if (val1 != "") [[likely]] {
+            return std::format("{}, {}", val1, val2);
+        }
+        else{
+            return val2;
+        }
+    };
+    const auto final = std::transform_reduce(vec.begin(), vec.end(), std::string(), join_vec, [&to_str](const T& val) -> std::string {return to_str(val);});
+    print("[{}]", final);
+}
+
+template<typename T>
+void print_vec(const std::vector<T>& vec){
+    return print_vec(vec,[](const T& val){ return std::to_string(val); });
+}
+
+auto split_str(std::string_view str, std::string_view substr){    
+    auto splits = str | std::ranges::views::split( substr);
+
+    std::vector<int> result;
+
+    for(const auto& k: splits){
+        result.push_back(str_to<int>(k.begin(), k.end()));
+    }
+
+    return result;
+}
+
+template <typename T>
+std::vector<T> remove_at(const std::vector<T>& vec, unsigned long at){
+    auto pruned_vec = std::vector<int>(vec);
+    pruned_vec.erase(std::next(pruned_vec.begin(), std::clamp(at, 0UL, pruned_vec.size())));
+    return pruned_vec;
+}
+
+bool is_safe(const auto& levels, bool found_bad_level_already = false){
+    // get adjacent differences
+    std::vector<int> adjacent_difference;
+    std::adjacent_difference(levels.begin(), levels.end(), std::back_inserter(adjacent_difference));
+    adjacent_difference.erase(adjacent_difference.begin());
+
+    std::vector<bool> adj_dif_values;
+    std::transform(adjacent_difference.begin(), adjacent_difference.end(), std::back_inserter(adj_dif_values), [](const int& val) -> bool {
+        auto abs_val = std::abs(val);
+        return abs_val >= 1 && abs_val <= 3;
+    });
+
+    std::vector<bool> swapped_sign;
+    std::adjacent_difference(adjacent_difference.begin(), adjacent_difference.end(), std::back_inserter(swapped_sign), [](const int& valA, const int& valB) -> bool {
+        return std::signbit(valA) == std::signbit(valB);
+    });
+
+    std::vector<bool> combined;
+    std::transform(adj_dif_values.begin(), adj_dif_values.end(), swapped_sign.begin(), std::back_inserter(combined), [](bool a, bool b){return a && b;});
+
+    // i am lazy so i will try the following
+    //print("Got level");
+    //print_vec(levels);
+    //print_vec(adj_dif_values);
+    //print_vec(swapped_sign);
+    //print_vec(combined);
+
+    // found adj value diff
+    if (auto iter = std::find(combined.begin(), combined.end(), false); iter != combined.end()){
+        if (found_bad_level_already){
+            return false;
+        }
+        auto dist = std::clamp(static_cast<unsigned long>(std::distance(combined.begin(), iter)), 0UL, levels.size());
+        
+        // check surrounding vectors
+        return (dist > 0 && is_safe(remove_at(levels, dist-1), true)) || 
+            is_safe(remove_at(levels, dist), true) || 
+            is_safe(remove_at(levels, dist+1), true);
+    }
+    
+    
+
+    return true;
+}
+
+class Line : public std::string {};
+
+std::istream &operator>>(std::istream &is, Line &l) {
+  std::getline(is, l);
+  return is;
+}
+
+struct LineWrapper {
+  std::reference_wrapper<std::ifstream> ref;
+  LineWrapper(std::ifstream &stream_) : ref(stream_){};
+  auto begin() { return std::istream_iterator<Line>(ref.get()); }
+  auto end() { return std::istream_iterator<Line>(); }
+};
+
+std::string read_file(std::ifstream &stream) {
+  std::ostringstream sstr;
+  sstr << stream.rdbuf();
+  return sstr.str();
+}
+
+int main(int argc, char** argv){
+	std::cout << "Hello World" << std::endl;
+
+    unsigned int safe_report = 0;
+    unsigned int line_number = 0;
+
+    auto reports = aoc::pipe::read_lines("input")
+        | aoc::pipe::transform([](const std::string& line){ return split_str(line, " "); })
+        | aoc::pipe::buffered(256);
+
+    for (const auto& levels: reports) {
+      ++line_number;
+      if (is_safe(levels)) {
+        print("{}", line_number);
+        ++safe_report;
+      }
+    }
+
+    print("result: {}", safe_report);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// a report is safe when its levels all go the same way in steps of 1 to 3.
+// the problem dampener forgives one bad level: the report is then safe if
+// dropping any single level makes it so.
+namespace report {
+
+constexpr bool is_safe_step(int from, int to, int direction) {
+  const auto step = (to - from) * direction;
+  return step >= 1 && step <= 3;
+}
+
+// single pass, constant state, no allocation: levels are pushed one at a
+// time (straight from the parser if need be) and both answers are ready at
+// any point. per direction it tracks whether the prefix is safe as is and
+// whether it is safe with one level dropped, both ending on the last level.
+class Scan {
+public:
+  constexpr void push(int level) {
+    for (auto d = 0UL; d < directions.size(); ++d) {
+      auto &s = states[d];
+      const auto direction = directions[d];
+      const auto strict = count == 0 || (s.strict_last &&
+                                         is_safe_step(last, level, direction));
+      // drop nothing new and extend the dampened prefix, or drop the
+      // previous level and extend the strict prefix before it
+      const auto dampened =
+          (count >= 1 && s.dampened_last &&
+           is_safe_step(last, level, direction)) ||
+          (count >= 2 ? s.strict_before_last &&
+                            is_safe_step(before_last, level, direction)
+                      : count == 1);
+      s.strict_before_last = s.strict_last;
+      s.strict_last = strict;
+      s.dampened_last = dampened;
+    }
+    before_last = last;
+    last = level;
+    ++count;
+  }
+
+  constexpr std::size_t size() const { return count; }
+
+  constexpr bool safe() const {
+    return states[0].strict_last || states[1].strict_last;
+  }
+
+  // dropping the last level is the one case the states do not cover yet
+  constexpr bool safe_dampened() const {
+    for (const auto &s : states) {
+      if (s.strict_last || s.dampened_last ||
+          (count < 2 || s.strict_before_last)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct State {
+    bool strict_last = true;
+    bool strict_before_last = true;
+    bool dampened_last = false;
+  };
+
+  static constexpr std::array<int, 2> directions{1, -1};
+
+  std::array<State, 2> states{};
+  int last = 0;
+  int before_last = 0;
+  std::size_t count = 0;
+};
+
+constexpr bool is_safe(std::span<const int> levels, bool dampened = false) {
+  Scan scan{};
+  for (const auto level : levels) {
+    scan.push(level);
+  }
+  return dampened ? scan.safe_dampened() : scan.safe();
+}
+
+// fewest levels to drop so the report becomes safe, O(n * max_removals):
+// per direction, best[i] is the fewest drops for a safe prefix that keeps
+// level i, reached from a kept level j at most max_removals + 1 back. anything
+// above max_removals comes back as max_removals + 1.
+inline std::size_t min_removals(std::span<const int> levels,
+                                std::size_t max_removals) {
+  const auto n = levels.size();
+  const auto too_many = max_removals + 1;
+  if (n <= 1) {
+    return 0;
+  }
+
+  std::vector<std::size_t> best(n);
+  auto fewest = too_many;
+  for (const auto direction : {1, -1}) {
+    for (auto i = 0UL; i < n; ++i) {
+      // dropping everything before i
+      best[i] = std::min(i, too_many);
+      const auto first = i > too_many ? i - too_many : 0;
+      for (auto j = first; j < i; ++j) {
+        if (is_safe_step(levels[j], levels[i], direction)) {
+          best[i] = std::min(best[i], best[j] + (i - j - 1));
+        }
+      }
+      // and everything after it
+      fewest = std::min(fewest, best[i] + (n - 1 - i));
+    }
+  }
+  return std::min(fewest, too_many);
+}
+
+} // namespace report
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "aoc/parallel.hpp"
+#include "scanner.hpp"
+
+// the do()/don't() flag makes the scan look sequential, but a piece of
+// memory is just a function of the state it is entered in: what it adds to
+// the sum and the state it leaves behind, for both entry states. those
+// compose associatively, so pieces can be scanned anywhere in any order and
+// folded left to right into the exact sequential answer.
+namespace instructions {
+
+struct Summary {
+  // indexed by the entry state, 0 disabled and 1 enabled
+  std::array<std::uint64_t, 2> sum{};
+  std::array<bool, 2> exit{false, true};
+
+  // this piece followed by `next`
+  constexpr Summary then(const Summary &next) const {
+    Summary result{};
+    for (auto entry = 0UL; entry < 2; ++entry) {
+      result.sum[entry] = sum[entry] + next.sum[exit[entry]];
+      result.exit[entry] = next.exit[exit[entry]];
+    }
+    return result;
+  }
+
+  constexpr std::uint64_t enabled_sum(bool enabled = true) const {
+    return sum[enabled];
+  }
+};
+
+// token visitor running both entry states side by side
+class Summarise {
+public:
+  constexpr void operator()(const Token &token) {
+    for (auto &k : from) {
+      k(token);
+    }
+  }
+
+  constexpr Summary summary() const {
+    return {{from[0].sum, from[1].sum}, {from[0].enabled, from[1].enabled}};
+  }
+
+private:
+  std::array<EnabledSum, 2> from{EnabledSum{0, false}, EnabledSum{0, true}};
+};
+
+// the tokens that start within text[begin, end); one still open at `end` is
+// finished from the bytes after it. a fresh scanner at `begin` falls in step
+// with the sequential one at the first 'm' or 'd', and until then the
+// sequential one only completes tokens that started before `begin`, so
+// every token is counted by exactly one piece
+inline Summary summarise(std::string_view text, std::size_t begin,
+                         std::size_t end,
+                         FindFn *find = find_candidate_kernel.bind()) {
+  Scanner scanner{};
+  Summarise visit{};
+  scanner.scan(text.substr(begin, end - begin), visit, find);
+  scanner.finish(text.substr(end), visit);
+  return visit.summary();
+}
+
+// text[0, end) split between the threads, the bytes past `end` are only
+// read to finish the last token
+inline Summary
+parallel_summarise(std::string_view text, std::size_t end,
+                   std::size_t threads = aoc::par::hardware_threads(),
+                   FindFn *find = find_candidate_kernel.bind()) {
+  const auto chunks = aoc::par::chunk_count(end, 1 << 20, threads);
+  std::vector<Summary> partial(chunks);
+  aoc::par::for_each_chunk(end, chunks, [&](auto i, aoc::par::Range range) {
+    partial[i] = summarise(text, range.begin, range.end, find);
+  });
+
+  Summary total{};
+  for (const auto &k : partial) {
+    total = total.then(k);
+  }
+  return total;
+}
+
+inline std::uint64_t
+parallel_enabled_sum(std::string_view text,
+                     std::size_t threads = aoc::par::hardware_threads()) {
+  return parallel_summarise(text, text.size(), threads).enabled_sum();
+}
+
+} // namespace instructions
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "aoc/pattern.hpp"
+#include "scanner.hpp"
+
+// the instruction set as patterns, in the order of Kind. the hand written
+// DFA in scanner.hpp stays the fast path, this is the one to copy for
+// variants of the format (another op is one more literal here and one more
+// Kind)
+namespace instructions {
+
+using Grammar =
+    aoc::pattern::Grammar<"mul(\\d{1,3},\\d{1,3})", "do()", "don't()">;
+
+constexpr std::uint64_t pattern_enabled_sum(std::string_view text) {
+  EnabledSum sum{};
+  Grammar::scan(text, [&](std::size_t which, const Grammar::Values &values) {
+    sum(Token{static_cast<Kind>(which), static_cast<unsigned int>(values[0]),
+              static_cast<unsigned int>(values[1])});
+  });
+  return sum.sum;
+}
+
+static_assert(pattern_enabled_sum(
+                  "xmul(2,4)&mul[3,7]!^don't()_mul(5,5)+mul(32,64]("
+                  "mul(11,8)undo()?mul(8,5))") == 48);
+static_assert(pattern_enabled_sum(
+                  "mumul(1,2)mul(1234,5)mul(12,3456)mul(0,7)") == 2);
+static_assert(pattern_enabled_sum("dodo()mul(2,3)don'do()mul(1,1)") == 7);
+
+} // namespace instructions
@@ -11,6 +11,7 @@
 #include <ostream>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
 #include <vector>
@@ -18,6 +19,12 @@
 #include <execution>
 #include <regex>
 
+#include "aoc/cpu.hpp"
+#include "aoc/pipeline.hpp"
+#include "aoc/text.hpp"
+#include "grammar.hpp"
+#include "stream.hpp"
+
 template <typename T, typename ...TArgs>
 T str_to(const std::string& str, TArgs&&... args){
     T result{};
@@ -59,41 +66,21 @@ void print_vec(const std::vector<T>& vec){
     return print_vec(vec,[](const T& val){ return std::to_string(val); });
 }
 
-auto get_mul_count(const std::string& str){
+// the regex path, kept to benchmark the scanner against (--regex)
+auto get_mul_count(const std::string& str, bool& is_enabled){
     static const std::regex mul_values(R"(mul\((\d{1,3}),(\d{1,3})\)|don't\(\)|do\(\))", std::regex_constants::optimize);
 
     unsigned long result = 0;
 
-    bool is_enabled = true;
-
     for(auto it = std::sregex_iterator(str.begin(), str.end(), mul_values); it != std::sregex_iterator(); ++it){
         if (it->str().compare("do()") == 0){
-            if (!is_enabled){
-                print("mul is disabled, enabling... {}", it->str());
-                is_enabled = true;
-            }
-            else {
-                 print("mul is still enabled... {}", it->str());           
-            }
+            is_enabled = true;
         }
         else if (it->str().compare("don't()") == 0){
-            if (is_enabled){
-                print("mul is enabled, disabling... {}", it->str());
-                is_enabled = false;
-            }
-            else{
-                print("mul is still disabled.. {}", it->str());
-            }
+            is_enabled = false;
         }
-        else{
-            if (!is_enabled){
-                print("mul is disabled, skipping this: {}", it->str());
-                continue;
-            }
-            // get regex values
-            auto base = it->str(), val1 = it->str(1), val2 = it->str(2);
-            print("got value: {}, calc {} * {}", base, val1, val2);
-            result += str_to<unsigned long>(val1) * str_to<unsigned long>(val2);
+        else if (is_enabled){
+            result += str_to<unsigned long>(it->str(1)) * str_to<unsigned long>(it->str(2));
         }
     }
 
@@ -116,28 +103,44 @@ struct LineWrapper {
 };
 
 
-std::string read_file( std::ifstream& stream ){
-    std::ostringstream sstr;
-    sstr << stream.rdbuf();
-    return sstr.str();
-}
-
 auto get_lines(std::ifstream& stream){
     return LineWrapper(stream);
 }
 
+// the first argument that is not an option, "-" for stdin
+std::string_view input_file(int argc, char** argv){
+    for (auto i = 1; i < argc; ++i) {
+        if (!std::string_view(argv[i]).starts_with("--")) {
+            return argv[i];
+        }
+    }
+    return "input";
+}
+
 int main(int argc, char** argv){
 	std::cout << "Hello World" << std::endl;
+    aoc::cpu::init(argc, argv);
 
-    std::ifstream myfile{};
-    myfile.open("input");
+    unsigned long result = 0;
 
-    std::string line;
-    
-    if (myfile.is_open()) {
-        print("got result {}", get_mul_count(read_file(myfile)));
-        myfile.close();
+    if (std::find(argv + 1, argv + argc, std::string_view("--regex")) != argv + argc) {
+        // no instruction spans a newline, so lines can be scanned one at a
+        // time as long as the do()/don't() state carries over between them
+        bool is_enabled = true;
+        for (const auto& line: aoc::pipe::read_lines(input_file(argc, argv)) | aoc::pipe::buffered(64)) {
+            result += get_mul_count(line, is_enabled);
+        }
+    }
+    else if (std::find(argv + 1, argv + argc, std::string_view("--pattern")) != argv + argc) {
+        // the compile-time pattern grammar over the whole input, see grammar.hpp
+        result = instructions::pattern_enabled_sum(aoc::text::read_file(input_file(argc, argv)));
     }
-    
+    else {
+        // fixed size blocks, each split between the threads, see stream.hpp
+        result = instructions::stream_enabled_sum(input_file(argc, argv));
+    }
+
+    print("got result {}", result);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "aoc/cpu.hpp"
+
+#if AOC_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// most of the corrupted memory can never start an instruction. the vector
+// paths compare 16/32/64 offsets at once against the first four bytes of
+// "mul(", "do()" (as "do(") and "don't(" (as "don'") so the DFA only runs
+// where one of them begins. offsets too close to the end to hold four bytes
+// are left to the DFA.
+namespace instructions {
+
+// first offset i < n that starts one of the prefixes, or that is within
+// three bytes of the end; n when there is none
+using FindFn = std::size_t(const char *, std::size_t);
+
+namespace detail {
+
+constexpr bool is_candidate(const char *p) {
+  return (p[0] == 'm' && p[1] == 'u' && p[2] == 'l' && p[3] == '(') ||
+         (p[0] == 'd' && p[1] == 'o' &&
+          (p[2] == '(' || (p[2] == 'n' && p[3] == '\'')));
+}
+
+inline std::size_t find_candidate_scalar(const char *text, std::size_t n) {
+  for (auto i = 0UL; i < n; ++i) {
+    if (i + 4 > n || is_candidate(text + i)) {
+      return i;
+    }
+  }
+  return n;
+}
+
+#if AOC_X86_DISPATCH
+// lambdas would not inherit the target attributes
+AOC_TARGET_SSE42 inline __m128i eq(__m128i bytes, char c) {
+  return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+}
+
+AOC_TARGET_AVX2 inline __m256i eq(__m256i bytes, char c) {
+  return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+
+AOC_TARGET_AVX512BW inline __mmask64 eq(__m512i bytes, char c) {
+  return _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(c));
+}
+
+AOC_TARGET_SSE42 inline std::size_t find_candidate_sse42(const char *text,
+                                                         std::size_t n) {
+  auto i = 0UL;
+  for (; i + 16 + 3 <= n; i += 16) {
+    const auto b0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+    const auto b1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + 1));
+    const auto b2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + 2));
+    const auto b3 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + 3));
+    const auto mul = _mm_and_si128(_mm_and_si128(eq(b0, 'm'), eq(b1, 'u')),
+                                   _mm_and_si128(eq(b2, 'l'), eq(b3, '(')));
+    const auto dont = _mm_and_si128(eq(b2, 'n'), eq(b3, '\''));
+    const auto d = _mm_and_si128(_mm_and_si128(eq(b0, 'd'), eq(b1, 'o')),
+                                 _mm_or_si128(eq(b2, '('), dont));
+    if (const auto mask = _mm_movemask_epi8(_mm_or_si128(mul, d)); mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+  return i + find_candidate_scalar(text + i, n - i);
+}
+
+AOC_TARGET_AVX2 inline std::size_t find_candidate_avx2(const char *text,
+                                                       std::size_t n) {
+  auto i = 0UL;
+  for (; i + 32 + 3 <= n; i += 32) {
+    const auto b0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+    const auto b1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + 1));
+    const auto b2 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + 2));
+    const auto b3 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + 3));
+    const auto mul =
+        _mm256_and_si256(_mm256_and_si256(eq(b0, 'm'), eq(b1, 'u')),
+                         _mm256_and_si256(eq(b2, 'l'), eq(b3, '(')));
+    const auto dont = _mm256_and_si256(eq(b2, 'n'), eq(b3, '\''));
+    const auto d = _mm256_and_si256(_mm256_and_si256(eq(b0, 'd'), eq(b1, 'o')),
+                                    _mm256_or_si256(eq(b2, '('), dont));
+    if (const auto mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_or_si256(mul, d)));
+        mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+  return i + find_candidate_scalar(text + i, n - i);
+}
+
+AOC_TARGET_AVX512BW inline std::size_t find_candidate_avx512bw(const char *text,
+                                                               std::size_t n) {
+  auto i = 0UL;
+  for (; i + 64 + 3 <= n; i += 64) {
+    const auto b0 = _mm512_loadu_si512(text + i);
+    const auto b1 = _mm512_loadu_si512(text + i + 1);
+    const auto b2 = _mm512_loadu_si512(text + i + 2);
+    const auto b3 = _mm512_loadu_si512(text + i + 3);
+    const auto mul = eq(b0, 'm') & eq(b1, 'u') & eq(b2, 'l') & eq(b3, '(');
+    const auto d = eq(b0, 'd') & eq(b1, 'o') &
+                   (eq(b2, '(') | (eq(b2, 'n') & eq(b3, '\'')));
+    if (const auto mask = mul | d; mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+    }
+  }
+  return i + find_candidate_scalar(text + i, n - i);
+}
+#endif
+
+} // namespace detail
+
+#if AOC_X86_DISPATCH
+inline constexpr aoc::cpu::Kernel<FindFn> find_candidate_kernel{
+    detail::find_candidate_scalar, detail::find_candidate_sse42,
+    detail::find_candidate_avx2, detail::find_candidate_avx512bw};
+#else
+inline constexpr aoc::cpu::Kernel<FindFn> find_candidate_kernel{
+    detail::find_candidate_scalar};
+#endif
+
+} // namespace instructions
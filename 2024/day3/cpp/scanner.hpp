@@ -0,0 +1,265 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "prefilter.hpp"
+
+// tokenizer for the corrupted memory: mul(a,b) with 1 to 3 digit operands,
+// do() and don't(), everything else is noise. a table driven DFA stands in
+// for the regex, one byte class lookup and one transition per byte and no
+// allocation. a failing byte is handled as if the scan restarted on it,
+// which finds the same matches as retrying the regex at every offset since
+// no instruction holds an 'm' or a 'd' past its first byte.
+namespace instructions {
+
+enum class Kind : std::uint8_t {
+  Mul,
+  Do,
+  Dont,
+};
+
+struct Token {
+  Kind kind;
+  unsigned int a = 0;
+  unsigned int b = 0;
+};
+
+namespace detail {
+
+enum Class : std::uint8_t {
+  Other,
+  M,
+  U,
+  L,
+  Open,
+  Close,
+  Comma,
+  Digit,
+  D,
+  O,
+  N,
+  Quote,
+  T,
+  class_count,
+};
+
+enum State : std::uint8_t {
+  Start,
+  MulM,
+  MulMu,
+  MulMul,
+  MulOpen,
+  A1,
+  A2,
+  A3,
+  MulComma,
+  B1,
+  B2,
+  B3,
+  DoD,
+  DoDo,
+  DoOpen,
+  DontN,
+  DontQuote,
+  DontT,
+  DontOpen,
+  state_count,
+};
+
+// what a transition does besides moving
+enum Action : std::uint8_t {
+  None,
+  FirstA,
+  NextA,
+  FirstB,
+  NextB,
+  EmitMul,
+  EmitDo,
+  EmitDont,
+};
+
+struct Table {
+  std::array<Class, 256> classes{};
+  std::array<std::array<State, class_count>, state_count> next{};
+  std::array<std::array<Action, class_count>, state_count> action{};
+};
+
+consteval Table build_table() {
+  Table table{};
+  for (auto c = '0'; c <= '9'; ++c) {
+    table.classes[static_cast<unsigned char>(c)] = Digit;
+  }
+  table.classes['m'] = M;
+  table.classes['u'] = U;
+  table.classes['l'] = L;
+  table.classes['('] = Open;
+  table.classes[')'] = Close;
+  table.classes[','] = Comma;
+  table.classes['d'] = D;
+  table.classes['o'] = O;
+  table.classes['n'] = N;
+  table.classes['\''] = Quote;
+  table.classes['t'] = T;
+
+  // by default every state fails over to what Start does with that byte
+  for (auto &row : table.next) {
+    row.fill(Start);
+    row[M] = MulM;
+    row[D] = DoD;
+  }
+
+  const auto edge = [&](State from, Class c, State to, Action action = None) {
+    table.next[from][c] = to;
+    table.action[from][c] = action;
+  };
+  edge(MulM, U, MulMu);
+  edge(MulMu, L, MulMul);
+  edge(MulMul, Open, MulOpen);
+  edge(MulOpen, Digit, A1, FirstA);
+  edge(A1, Digit, A2, NextA);
+  edge(A2, Digit, A3, NextA);
+  edge(A1, Comma, MulComma);
+  edge(A2, Comma, MulComma);
+  edge(A3, Comma, MulComma);
+  edge(MulComma, Digit, B1, FirstB);
+  edge(B1, Digit, B2, NextB);
+  edge(B2, Digit, B3, NextB);
+  edge(B1, Close, Start, EmitMul);
+  edge(B2, Close, Start, EmitMul);
+  edge(B3, Close, Start, EmitMul);
+
+  edge(DoD, O, DoDo);
+  edge(DoDo, Open, DoOpen);
+  edge(DoOpen, Close, Start, EmitDo);
+  edge(DoDo, N, DontN);
+  edge(DontN, Quote, DontQuote);
+  edge(DontQuote, T, DontT);
+  edge(DontT, Open, DontOpen);
+  edge(DontOpen, Close, Start, EmitDont);
+  return table;
+}
+
+inline constexpr Table table = build_table();
+
+} // namespace detail
+
+// resumable: feeding a text in pieces gives the same tokens as feeding it
+// whole, a token cut by the end of one piece is finished by the next
+class Scanner {
+public:
+  // visit(Token) for every instruction completed within `text`
+  template <typename Visitor>
+  constexpr void feed(std::string_view text, Visitor &&visit) {
+    for (const auto c : text) {
+      step(c, visit);
+    }
+  }
+
+  // same tokens as feed(), but while idle the bytes that cannot start an
+  // instruction are skipped by the prefilter
+  template <typename Visitor>
+  void scan(std::string_view text, Visitor &&visit,
+            FindFn *find = find_candidate_kernel.bind()) {
+    for (auto i = 0UL; i < text.size();) {
+      if (idle()) {
+        i += find(text.data() + i, text.size() - i);
+        if (i == text.size()) {
+          break;
+        }
+      }
+      step(text[i++], visit);
+    }
+  }
+
+  // completes the token in progress, if any, from the bytes that follow it
+  // without starting a new one; a new one only ever starts at 'm' or 'd'
+  template <typename Visitor>
+  constexpr void finish(std::string_view rest, Visitor &&visit) {
+    for (const auto c : rest) {
+      if (idle() || c == 'm' || c == 'd') {
+        return;
+      }
+      step(c, visit);
+    }
+  }
+
+  // no token in progress, so what follows can be scanned by anyone
+  constexpr bool idle() const { return state == detail::Start; }
+
+private:
+  template <typename Visitor> constexpr void step(char c, Visitor &visit) {
+    using namespace detail;
+    const auto k = table.classes[static_cast<unsigned char>(c)];
+    const auto digit = static_cast<unsigned int>(c - '0');
+    const auto action = table.action[state][k];
+    state = table.next[state][k];
+    switch (action) {
+    case None:
+      break;
+    case FirstA:
+      a = digit;
+      break;
+    case NextA:
+      a = a * 10 + digit;
+      break;
+    case FirstB:
+      b = digit;
+      break;
+    case NextB:
+      b = b * 10 + digit;
+      break;
+    case EmitMul:
+      visit(Token{Kind::Mul, a, b});
+      break;
+    case EmitDo:
+      visit(Token{Kind::Do});
+      break;
+    case EmitDont:
+      visit(Token{Kind::Dont});
+      break;
+    }
+  }
+
+  detail::State state = detail::Start;
+  unsigned int a = 0;
+  unsigned int b = 0;
+};
+
+// sum of the products while mul is enabled, do()/don't() flip `enabled`
+// and it carries over to the next call
+class EnabledSum {
+public:
+  constexpr void operator()(const Token &token) {
+    switch (token.kind) {
+    case Kind::Mul:
+      sum += enabled ? std::uint64_t{token.a} * token.b : 0;
+      break;
+    case Kind::Do:
+      enabled = true;
+      break;
+    case Kind::Dont:
+      enabled = false;
+      break;
+    }
+  }
+
+  std::uint64_t sum = 0;
+  bool enabled = true;
+};
+
+constexpr std::uint64_t enabled_sum(std::string_view text) {
+  Scanner scanner{};
+  EnabledSum sum{};
+  scanner.feed(text, sum);
+  return sum.sum;
+}
+
+static_assert(enabled_sum("xmul(2,4)&mul[3,7]!^don't()_mul(5,5)+mul(32,64]("
+                          "mul(11,8)undo()?mul(8,5))") == 48);
+static_assert(enabled_sum("mumul(1,2)mul(1234,5)mul(12,3456)mul(0,7)") == 2);
+static_assert(enabled_sum("dodo()mul(2,3)don'do()mul(1,1)") == 7);
+
+} // namespace instructions
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "aoc/parallel.hpp"
+#include "chunked.hpp"
+
+// the same sum in constant memory: the input is read in fixed size blocks,
+// whatever its line lengths. tokens starting in the last max_token bytes of
+// a block may run past it, so those bytes are carried to the front of the
+// next block instead of being scanned; every block is still split between
+// the threads and the block summaries fold like the chunk ones.
+namespace instructions {
+
+// "mul(123,456)"
+inline constexpr std::size_t max_token = 12;
+
+inline std::uint64_t
+stream_enabled_sum(std::istream &stream, std::size_t block_size = 1 << 24,
+                   std::size_t threads = aoc::par::hardware_threads()) {
+  std::string block(std::max(block_size, 4 * max_token), '\0');
+  auto *find = find_candidate_kernel.bind();
+
+  Summary total{};
+  std::size_t carry = 0;
+  while (true) {
+    stream.read(block.data() + carry,
+                static_cast<std::streamsize>(block.size() - carry));
+    const auto filled = carry + static_cast<std::size_t>(stream.gcount());
+    const auto last = !stream;
+    const auto text = std::string_view(block).substr(0, filled);
+
+    const auto end = last ? filled : filled - max_token;
+    total = total.then(parallel_summarise(text, end, threads, find));
+    if (last) {
+      break;
+    }
+    carry = filled - end;
+    std::copy(text.begin() + end, text.end(), block.begin());
+  }
+  return total.enabled_sum();
+}
+
+// "-" reads stdin
+inline std::uint64_t
+stream_enabled_sum(std::string_view file, std::size_t block_size = 1 << 24,
+                   std::size_t threads = aoc::par::hardware_threads()) {
+  if (file == "-") {
+    return stream_enabled_sum(std::cin, block_size, threads);
+  }
+  std::ifstream stream{std::string(file), std::ios::binary};
+  if (!stream.is_open()) {
+    throw std::system_error(
+        std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+  return stream_enabled_sum(stream, block_size, threads);
+}
+
+} // namespace instructions
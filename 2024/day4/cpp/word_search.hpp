@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <string>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "aoc/aho_corasick.hpp"
+#include "aoc/and_count.hpp"
+#include "aoc/bitgrid.hpp"
+#include "aoc/grid.hpp"
+#include "aoc/parallel.hpp"
+
+// word search on bit planes: one plane per letter of the word, and the word
+// runs along (dr, dc) from the cells where plane 0 is set, plane 1 is set
+// one step further, and so on. with BitGrid::word that is one AND per
+// letter for 64 start cells, and the matches are a popcount.
+//
+// many words at once go through one Aho-Corasick automaton instead, over
+// the words and their reversals, so every row, column and diagonal is read
+// once in one direction and still yields the matches for all eight.
+namespace word_search {
+
+// (dr, dc) for right, left, down, up and the four diagonals
+inline constexpr std::array<std::pair<int, int>, 8> directions{{
+    {0, 1},
+    {0, -1},
+    {1, 0},
+    {-1, 0},
+    {1, 1},
+    {-1, -1},
+    {1, -1},
+    {-1, 1},
+}};
+
+// the planes of each letter of `word`, in word order, from one pass over
+// the grid
+inline std::vector<aoc::BitGrid>
+letter_planes(const aoc::Grid<char> &grid, std::string_view word,
+              std::size_t threads = aoc::par::hardware_threads()) {
+  return aoc::BitGrid::equal(grid, word, threads);
+}
+
+// bit i: the word runs from (r, c + i) along (dr, dc)
+inline std::uint64_t starts(const std::vector<aoc::BitGrid> &planes,
+                            std::ptrdiff_t r, std::ptrdiff_t c, int dr,
+                            int dc) {
+  auto found = ~std::uint64_t{0};
+  for (auto i = 0L; i < static_cast<std::ptrdiff_t>(planes.size()) && found;
+       ++i) {
+    found &= planes[i].word(r + i * dr, c + i * dc);
+  }
+  return found;
+}
+
+// every occurrence along all 8 directions, as counting by hand would (a
+// palindrome is found once each way). starts() checks every read against
+// the edges, so it only covers the first and last word of each row; the
+// words in between go to kernels::and_count with the row of every letter
+// and its shift worked out once per row and direction
+inline std::size_t
+count_word(const aoc::Grid<char> &grid, std::string_view word,
+           std::size_t threads = aoc::par::hardware_threads()) {
+  if (word.empty()) {
+    return 0;
+  }
+  const auto planes = letter_planes(grid, word, threads);
+  const auto words = planes[0].words();
+  const auto rows = static_cast<std::ptrdiff_t>(grid.rows());
+  const auto length = static_cast<std::ptrdiff_t>(word.size());
+  // letter k sits k columns to either side, at most one word over; longer
+  // words only go through starts()
+  const auto inner = word.size() <= 64 && words > 2 ? words - 1 : 1;
+  auto *and_count = aoc::kernels::and_count_kernel.bind();
+
+  const auto chunks = aoc::par::chunk_count(grid.rows(), 64, threads);
+  std::vector<std::size_t> partial(chunks);
+  aoc::par::for_each_chunk(
+      grid.rows(), chunks, [&](auto i, aoc::par::Range range) {
+        std::size_t count = 0;
+        std::vector<const std::uint64_t *> letters(word.size());
+        std::vector<unsigned> shifts(word.size());
+        for (auto r = static_cast<std::ptrdiff_t>(range.begin);
+             r < static_cast<std::ptrdiff_t>(range.end); ++r) {
+          for (const auto &[dr, dc] : directions) {
+            // no start on this row fits the word
+            const auto last = r + (length - 1) * dr;
+            if (last < 0 || last >= rows) {
+              continue;
+            }
+            for (auto k = 0L; k < length; ++k) {
+              const auto at = static_cast<std::size_t>(k);
+              // a step left starts one word back
+              const auto offset = k * dc;
+              letters[at] =
+                  planes[at].row(static_cast<std::size_t>(r + k * dr)) +
+                  (offset < 0 ? -1 : 0);
+              shifts[at] = static_cast<unsigned>(offset & 63);
+            }
+            const auto edge = [&](std::size_t w) {
+              count += static_cast<std::size_t>(std::popcount(starts(
+                  planes, r, static_cast<std::ptrdiff_t>(w * 64), dr, dc)));
+            };
+
+            edge(0);
+            count += and_count(letters.data(), shifts.data(), word.size(), 1,
+                               inner);
+            for (auto w = inner; w < words; ++w) {
+              edge(w);
+            }
+          }
+        }
+        partial[i] = count;
+      });
+
+  std::size_t total = 0;
+  for (const auto k : partial) {
+    total += k;
+  }
+  return total;
+}
+
+struct Match {
+  std::size_t word;
+  // the first letter, and the direction the word runs in from there
+  std::size_t row;
+  std::size_t col;
+  int dr;
+  int dc;
+};
+
+struct Found {
+  // per word, in the order given
+  std::vector<std::size_t> counts{};
+  // only filled when asked for, in no particular order
+  std::vector<Match> matches{};
+};
+
+namespace detail {
+
+// reports a match of automaton pattern `pattern` ending on (r, c) while
+// reading along (dr, dc); patterns past the words are the reversals
+inline void report(const aoc::AhoCorasick &automaton, std::size_t words,
+                   bool positions, Found &found, std::size_t pattern,
+                   std::size_t r, std::size_t c, int dr, int dc) {
+  const auto forward = pattern < words;
+  const auto word = forward ? pattern : pattern - words;
+  ++found.counts[word];
+  if (!positions) {
+    return;
+  }
+  if (forward) {
+    // back to the first letter
+    const auto back = static_cast<std::ptrdiff_t>(automaton.length(pattern)) - 1;
+    found.matches.push_back(
+        {word, static_cast<std::size_t>(static_cast<std::ptrdiff_t>(r) - back * dr),
+         static_cast<std::size_t>(static_cast<std::ptrdiff_t>(c) - back * dc), dr,
+         dc});
+  } else {
+    // a reversed match ends on the word's first letter
+    found.matches.push_back({word, r, c, -dr, -dc});
+  }
+}
+
+} // namespace detail
+
+// every occurrence of every word along all 8 directions, counted the same
+// way as count_word. rows are scanned as they are; columns and both
+// diagonal families are scanned side by side, one automaton state per line
+// and the grid read row by row, so the walk stays in cache. each family is
+// split into bands of lines between the threads.
+inline Found find_words(const aoc::Grid<char> &grid,
+                        std::span<const std::string_view> words,
+                        bool positions = false,
+                        std::size_t threads = aoc::par::hardware_threads()) {
+  // words, then the same words reversed
+  std::vector<std::string> reversed{};
+  std::vector<std::string_view> patterns(words.begin(), words.end());
+  reversed.reserve(words.size());
+  for (const auto word : words) {
+    reversed.emplace_back(word.rbegin(), word.rend());
+  }
+  patterns.insert(patterns.end(), reversed.begin(), reversed.end());
+  const aoc::AhoCorasick automaton(patterns);
+
+  const auto rows = grid.rows();
+  const auto cols = grid.cols();
+  std::vector<Found> partial{};
+  const auto run = [&](std::size_t lines, auto scan_band) {
+    const auto chunks = aoc::par::chunk_count(lines, 64, threads);
+    const auto first = partial.size();
+    partial.resize(first + chunks);
+    aoc::par::for_each_chunk(lines, chunks,
+                             [&](auto i, aoc::par::Range range) {
+                               auto &found = partial[first + i];
+                               found.counts.assign(words.size(), 0);
+                               scan_band(range, found);
+                             });
+  };
+
+  run(rows, [&](aoc::par::Range range, Found &found) {
+    for (auto r = range.begin; r < range.end; ++r) {
+      const auto row = grid.row(r);
+      automaton.scan(std::string_view(row.data(), row.size()),
+                     [&](std::size_t pattern, std::size_t end) {
+                       detail::report(automaton, words.size(), positions,
+                                      found, pattern, r, end - 1, 0, 1);
+                     });
+    }
+  });
+
+  // line ids for (r, c) going down: c for columns, c - r + rows - 1 down
+  // to the right, c + r down to the left
+  const auto ids = rows + cols - 1;
+  for (const auto dc : {0, 1, -1}) {
+    run(dc == 0 ? cols : ids, [&](aoc::par::Range range, Found &found) {
+      std::vector<aoc::AhoCorasick::State> states(range.size(), 0);
+      for (auto r = 0UL; r < rows; ++r) {
+        // id = c + shift
+        const auto shift = dc == 0   ? 0L
+                           : dc == 1 ? static_cast<std::ptrdiff_t>(rows - 1 - r)
+                                     : static_cast<std::ptrdiff_t>(r);
+        // the columns of this row on the band's lines
+        const auto begin = std::max<std::ptrdiff_t>(
+            0, static_cast<std::ptrdiff_t>(range.begin) - shift);
+        const auto end = std::min<std::ptrdiff_t>(
+            static_cast<std::ptrdiff_t>(cols),
+            static_cast<std::ptrdiff_t>(range.end) - shift);
+        for (auto c = begin; c < end; ++c) {
+          auto &state = states[static_cast<std::size_t>(c + shift) - range.begin];
+          state = automaton.next(state, grid(r, static_cast<std::size_t>(c)));
+          for (const auto pattern : automaton.matches(state)) {
+            detail::report(automaton, words.size(), positions, found, pattern,
+                           r, static_cast<std::size_t>(c), 1, dc);
+          }
+        }
+      }
+    });
+  }
+
+  Found total{std::vector<std::size_t>(words.size(), 0), {}};
+  for (const auto &k : partial) {
+    for (auto w = 0UL; w < words.size(); ++w) {
+      total.counts[w] += k.counts[w];
+    }
+    total.matches.insert(total.matches.end(), k.matches.begin(),
+                         k.matches.end());
+  }
+  return total;
+}
+
+} // namespace word_search
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "aoc/grid.hpp"
+#include "aoc/parallel.hpp"
+
+// X-MAS: an 'A' with "MAS" written either way along both diagonals through
+// it. the centres are split into bands of rows between the threads, each
+// band also reading the halo row above and below it straight from the grid.
+// the check is a branch free 3x3 stencil over three row pointers, so the
+// inner loop is plain byte compares the compiler can vectorise. centres on
+// the border never match, their stencil would leave the grid.
+namespace x_mas {
+
+// 1 when the 3x3 block centred on column c of `mid` is an X-MAS
+inline unsigned int stencil(const char *up, const char *mid, const char *down,
+                            std::size_t c) {
+  const auto is = [](char cell, char letter) {
+    return static_cast<unsigned int>(cell == letter);
+  };
+  const auto falling = (is(up[c - 1], 'M') & is(down[c + 1], 'S')) |
+                       (is(up[c - 1], 'S') & is(down[c + 1], 'M'));
+  const auto rising = (is(down[c - 1], 'M') & is(up[c + 1], 'S')) |
+                      (is(down[c - 1], 'S') & is(up[c + 1], 'M'));
+  return is(mid[c], 'A') & falling & rising;
+}
+
+// visit(r, c) for every centre of rows [begin, end)
+template <typename Visitor>
+void for_each_centre(const aoc::Grid<char> &grid, std::size_t begin,
+                     std::size_t end, Visitor visit) {
+  for (auto r = begin; r < end; ++r) {
+    const auto *up = grid.row(r - 1).data();
+    const auto *mid = grid.row(r).data();
+    const auto *down = grid.row(r + 1).data();
+    for (auto c = 1UL; c + 1 < grid.cols(); ++c) {
+      if (stencil(up, mid, down, c) != 0) {
+        visit(r, c);
+      }
+    }
+  }
+}
+
+inline std::size_t count(const aoc::Grid<char> &grid,
+                         std::size_t threads = aoc::par::hardware_threads()) {
+  if (grid.rows() < 3 || grid.cols() < 3) {
+    return 0;
+  }
+  const auto centres = grid.rows() - 2;
+  const auto chunks = aoc::par::chunk_count(centres, 64, threads);
+  std::vector<std::size_t> partial(chunks);
+  aoc::par::for_each_chunk(centres, chunks, [&](auto i, aoc::par::Range range) {
+    std::size_t count = 0;
+    for (auto r = range.begin + 1; r < range.end + 1; ++r) {
+      const auto *up = grid.row(r - 1).data();
+      const auto *mid = grid.row(r).data();
+      const auto *down = grid.row(r + 1).data();
+      for (auto c = 1UL; c + 1 < grid.cols(); ++c) {
+        count += stencil(up, mid, down, c);
+      }
+    }
+    partial[i] = count;
+  });
+
+  std::size_t total = 0;
+  for (const auto k : partial) {
+    total += k;
+  }
+  return total;
+}
+
+// the grid with everything but the cells of an X-MAS replaced by `blank`,
+// a separate pass so counting never pays for it
+inline aoc::Grid<char> render(const aoc::Grid<char> &grid, char blank = '.') {
+  aoc::Grid<char> masked(grid.rows(), grid.cols(), blank);
+  if (grid.rows() < 3 || grid.cols() < 3) {
+    return masked;
+  }
+  for_each_centre(grid, 1, grid.rows() - 1, [&](std::size_t r, std::size_t c) {
+    // the centre and its four corners
+    for (const auto &[row, col] :
+         {std::pair{r, c}, std::pair{r - 1, c - 1}, std::pair{r - 1, c + 1},
+          std::pair{r + 1, c - 1}, std::pair{r + 1, c + 1}}) {
+      masked(row, col) = grid(row, col);
+    }
+  });
+  return masked;
+}
+
+} // namespace x_mas
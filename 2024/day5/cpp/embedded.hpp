@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "aoc/ct_parse.hpp"
+#include "aoc/embedded_input.hpp"
+#include "manual.hpp"
+
+// the input baked in with AOC_EMBED_INPUT_DIR: the compiler splits it into
+// rule pairs and update pages, and manual() turns those into the same
+// Manual that parse_manual gives at run time, so both builds run the same
+// checks on the same RuleSet and only the parsing moves.
+namespace ordering::embedded {
+
+inline constexpr auto sections = aoc::ct::split_sections(aoc::embedded_input);
+
+template <std::size_t Updates, std::size_t Pages> struct UpdatePages {
+  std::array<unsigned int, Pages> pages{};
+  std::array<std::size_t, Updates + 1> offsets{};
+};
+
+// `before|after` per rule line
+inline constexpr auto rules = [] {
+  constexpr auto text = sections.first;
+  std::array<std::pair<unsigned int, unsigned int>,
+             aoc::ct::count_lines(text)>
+      rules{};
+
+  auto rest = text;
+  auto rule = 0UL;
+  while (!rest.empty()) {
+    auto line = aoc::ct::next_line(rest);
+    if (line.empty()) {
+      continue;
+    }
+    rules[rule].first = aoc::ct::parse_uint<unsigned int>(line);
+    rules[rule].second = aoc::ct::parse_uint<unsigned int>(line);
+    ++rule;
+  }
+  return rules;
+}();
+
+// every update's pages back to back, update i at [offsets[i], offsets[i + 1])
+inline constexpr auto updates = [] {
+  constexpr auto text = sections.second;
+  UpdatePages<aoc::ct::count_lines(text), aoc::ct::count_numbers(text)>
+      updates{};
+
+  auto rest = text;
+  auto update = 0UL;
+  auto page = 0UL;
+  while (!rest.empty()) {
+    auto line = aoc::ct::next_line(rest);
+    if (line.empty()) {
+      continue;
+    }
+    updates.offsets[update++] = page;
+    while (!line.empty()) {
+      updates.pages[page++] = aoc::ct::parse_uint<unsigned int>(line);
+    }
+  }
+  updates.offsets[update] = page;
+  return updates;
+}();
+
+inline Manual manual() {
+  Manual manual{};
+  for (const auto &[before, after] : rules) {
+    manual.rules.add(before, after);
+  }
+  manual.updates.reserve(updates.offsets.size() - 1);
+  for (auto i = 0UL; i + 1 < updates.offsets.size(); ++i) {
+    manual.updates.emplace_back(
+        std::next(updates.pages.begin(),
+                  static_cast<long>(updates.offsets[i])),
+        std::next(updates.pages.begin(),
+                  static_cast<long>(updates.offsets[i + 1])));
+  }
+  return manual;
+}
+
+} // namespace ordering::embedded
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "aoc/parallel.hpp"
+#include "aoc/text.hpp"
+#include "rule_set.hpp"
+
+// a whole input, its rules and its updates, as a plain value. nothing is
+// shared between two manuals and checking one only reads its RuleSet, so
+// any number of them can be parsed and checked on different threads at
+// once, which is what check_files does for a batch of inputs.
+namespace ordering {
+
+template <typename Rules>
+bool is_valid_update(const std::vector<unsigned int> &page_numbers,
+                     const Rules &has_rule) {
+  for (auto i = 0UL; i < page_numbers.size(); ++i) {
+    for (auto j = i + 1; j < page_numbers.size(); ++j) {
+      // if i is a child of j, then the rule is being broken
+      if (has_rule(page_numbers[j], page_numbers[i])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Rules>
+void fix_update_rule(std::vector<unsigned int> &page_numbers,
+                     const Rules &has_rule) {
+  while (!is_valid_update(page_numbers, has_rule)) {
+    for (auto i = 0UL; i < page_numbers.size(); ++i) {
+      const auto i_page = page_numbers[i];
+
+      for (auto j = i + 1; j < page_numbers.size(); ++j) {
+        // if i is a child of j, then the rule is being broken
+        if (has_rule(page_numbers[j], i_page)) {
+          std::swap(page_numbers.at(i), page_numbers.at(j));
+        }
+      }
+    }
+  }
+}
+
+struct Manual {
+  RuleSet rules{};
+  std::vector<std::vector<unsigned int>> updates{};
+};
+
+namespace detail {
+
+// the numbers of `line` split at `separator`
+inline std::vector<unsigned int> parse_numbers(std::string_view line,
+                                               char separator) {
+  std::vector<unsigned int> numbers{};
+  while (!line.empty()) {
+    const auto end = std::min(line.find(separator), line.size());
+    unsigned int value = 0;
+    const auto [ptr, ec] =
+        std::from_chars(line.data(), line.data() + end, value);
+    if (ec != std::errc()) {
+      throw std::system_error(std::make_error_code(ec));
+    }
+    numbers.push_back(value);
+    line.remove_prefix(std::min(end + 1, line.size()));
+  }
+  return numbers;
+}
+
+} // namespace detail
+
+// "a|b" rules, a blank line, then "a,b,c" updates
+inline Manual parse_manual(std::string_view text) {
+  Manual manual{};
+  auto input_is_rules = true;
+  while (!text.empty()) {
+    const auto end = std::min(text.find('\n'), text.size());
+    auto line = text.substr(0, end);
+    text.remove_prefix(std::min(end + 1, text.size()));
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+
+    // updates are next
+    if (line.empty()) {
+      input_is_rules = false;
+      continue;
+    }
+    if (input_is_rules) {
+      const auto rule = detail::parse_numbers(line, '|');
+      if (rule.size() != 2) {
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+      }
+      manual.rules.add(rule[0], rule[1]);
+    } else {
+      manual.updates.push_back(detail::parse_numbers(line, ','));
+    }
+  }
+  return manual;
+}
+
+// sum of the middle pages of the updates that are already in order. this
+// only reads the rules: fix_update_rule never ends when the rules between
+// an update's pages form a cycle, and part 1 has no reason to run it
+inline unsigned long valid_middles(const Manual &manual) {
+  auto sum = 0UL;
+  for (const auto &update : manual.updates) {
+    if (!update.empty() && is_valid_update(update, manual.rules)) {
+      sum += update[update.size() / 2];
+    }
+  }
+  return sum;
+}
+
+// sum of the middle pages of the updates that are out of order, after
+// fixing them
+inline unsigned long fixed_middles(const Manual &manual) {
+  auto sum = 0UL;
+  for (const auto &update : manual.updates) {
+    if (update.empty() || is_valid_update(update, manual.rules)) {
+      continue;
+    }
+    auto fixed = update;
+    fix_update_rule(fixed, manual.rules);
+    sum += fixed[fixed.size() / 2];
+  }
+  return sum;
+}
+
+// every file read, parsed and summed with `check` (valid_middles or
+// fixed_middles) on its own, files split between the threads; results in
+// the order of `files`
+template <typename Check>
+std::vector<unsigned long>
+check_files(const std::vector<std::string_view> &files, const Check &check,
+            std::size_t threads = aoc::par::hardware_threads()) {
+  std::vector<unsigned long> sums(files.size());
+  aoc::par::for_each_chunk(
+      files.size(), std::min(files.size(), threads),
+      [&](auto, aoc::par::Range range) {
+        for (auto i = range.begin; i < range.end; ++i) {
+          sums[i] = check(parse_manual(aoc::text::read_file(files[i])));
+        }
+      });
+  return sums;
+}
+
+} // namespace ordering
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "aoc/flat_map.hpp"
+
+// the ordering rules as a matrix of bits, row `before` holding a bit for
+// every page that has to come after it, so a rule lookup is one bit test.
+// the matrix grows with the largest page seen; pages past dense_limit would
+// make it too big, and the rules move to a hash set of page pairs instead.
+// a RuleSet is a plain value: copies are independent, and lookups never
+// write, so one set can be read from any number of threads at once.
+namespace ordering {
+
+// 4096 x 4096 bits is 2 MiB
+inline constexpr std::size_t dense_limit = 4096;
+
+class RuleSet {
+public:
+  // rule `before|after`: page `before` has to be printed ahead of `after`
+  void add(unsigned int before, unsigned int after) {
+    if (!sparse) {
+      const auto largest = before > after ? before : after;
+      if (largest >= side) {
+        grow(static_cast<std::size_t>(largest) + 1);
+      }
+    }
+    if (sparse) {
+      rules[key(before, after)] = true;
+      return;
+    }
+    bits[before * stride + after / 64] |= std::uint64_t{1} << (after % 64);
+  }
+
+  bool operator()(unsigned int before, unsigned int after) const {
+    if (sparse) {
+      return rules.find(key(before, after)) != nullptr;
+    }
+    return before < side && after < side &&
+           ((bits[before * stride + after / 64] >> (after % 64)) & 1U) != 0;
+  }
+
+  bool dense() const { return !sparse; }
+
+private:
+  static std::uint64_t key(unsigned int before, unsigned int after) {
+    return (std::uint64_t{before} << 32) | after;
+  }
+
+  // at least `pages` rows and columns, doubling so adding rules in page
+  // order stays linear
+  void grow(std::size_t pages) {
+    auto wanted = side == 0 ? 64 : side;
+    while (wanted < pages) {
+      wanted *= 2;
+    }
+    if (wanted > dense_limit) {
+      for (auto before = 0UL; before < side; ++before) {
+        for (auto w = 0UL; w < stride; ++w) {
+          for (auto word = bits[before * stride + w]; word != 0;
+               word &= word - 1) {
+            const auto after = w * 64 + static_cast<std::size_t>(
+                                            std::countr_zero(word));
+            rules[key(static_cast<unsigned int>(before),
+                      static_cast<unsigned int>(after))] = true;
+          }
+        }
+      }
+      sparse = true;
+      bits = {};
+      return;
+    }
+
+    const auto wider = wanted / 64;
+    std::vector<std::uint64_t> moved(wanted * wider, 0);
+    for (auto before = 0UL; before < side; ++before) {
+      for (auto w = 0UL; w < stride; ++w) {
+        moved[before * wider + w] = bits[before * stride + w];
+      }
+    }
+    bits = std::move(moved);
+    side = wanted;
+    stride = wider;
+  }
+
+  bool sparse = false;
+  // pages per side of the matrix and words per row
+  std::size_t side = 0;
+  std::size_t stride = 0;
+  std::vector<std::uint64_t> bits{};
+  aoc::FlatMap<std::uint64_t, bool> rules{};
+};
+
+} // namespace ordering
@@ -24,6 +24,8 @@
 #include <utility>
 #include <vector>
 
+#include "aoc/pipeline.hpp"
+
 const char *ws = " \t\n\r\f\v";
 
 // trim from end of string (right)
@@ -291,10 +293,12 @@ Equation parse_equation(const std::string &equation) {
 int main(int argc, char **argv) {
   std::cout << "Hello World" << std::endl;
 
-  std::vector<Equation> equations;
-  auto lines = get_lines("input");
-  std::transform(lines.begin(), lines.end(), std::back_inserter(equations),
-                 [](const auto &k) { return parse_equation(k); });
+  // parse on a producer thread while the solver works through the backlog,
+  // only a bounded window of equations is ever alive at once
+  auto equations = aoc::pipe::read_lines("input") |
+                   aoc::pipe::transform(
+                       [](const auto &k) { return parse_equation(k); }) |
+                   aoc::pipe::buffered(256);
 
   long int total_value = 0L;
   for (const auto &k : equations) {
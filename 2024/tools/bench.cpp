@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "run.hpp"
+
+// aoc_bench [options] <build> [baseline-build]
+//
+// times every solver of <build> on generated inputs and, given a baseline
+// build tree (usually the plain -O2 one), prints the speedup per day and
+// part. with --train every solver just runs once on the training input,
+// which is what the pgo-train target uses to collect profiles.
+//
+// with --embedded the comparison is startup to answer of the same sources
+// built with AOC_EMBED_INPUT_DIR pointing at the generated inputs (see
+// aoc_embed_input.cmake) against <build> reading ./input at run time. the
+// embedded tree is configured and built inside the work directory, extra
+// configure options go in with --cmake-arg; the embedded solvers run in an
+// empty directory, so they cannot fall back to reading an input. days that
+// do not embed their input are skipped, --days=1,5 saves building them.
+namespace fs = std::filesystem;
+
+struct Options {
+  fs::path build{};
+  std::optional<fs::path> baseline{};
+  std::vector<unsigned int> days{};
+  std::vector<std::string> args{};
+  std::vector<std::string> baseline_args{};
+  std::vector<std::string> cmake_args{};
+  unsigned int runs = 5;
+  unsigned int scale = 1;
+  std::uint64_t seed = 2024;
+  bool train = false;
+  bool embedded = false;
+};
+
+template <typename T> bool parse(std::string_view arg, T &value) {
+  const auto [ptr, ec] =
+      std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc() && ptr == arg.data() + arg.size();
+}
+
+std::optional<Options> parse_options(int argc, char **argv) {
+  Options options{};
+  std::vector<std::string_view> positional{};
+  for (auto i = 1; i < argc; ++i) {
+    const auto arg = std::string_view(argv[i]);
+    const auto value = arg.substr(std::min(arg.find('=') + 1, arg.size()));
+    bool ok = true;
+    if (arg == "--train") {
+      options.train = true;
+    } else if (arg == "--embedded") {
+      options.embedded = true;
+    } else if (arg.starts_with("--cmake-arg=")) {
+      options.cmake_args.emplace_back(value);
+    } else if (arg.starts_with("--runs=")) {
+      ok = parse(value, options.runs) && options.runs > 0;
+    } else if (arg.starts_with("--scale=")) {
+      ok = parse(value, options.scale) && options.scale > 0;
+    } else if (arg.starts_with("--seed=")) {
+      ok = parse(value, options.seed);
+    } else if (arg.starts_with("--days=")) {
+      for (auto rest = value; ok && !rest.empty();) {
+        const auto end = std::min(rest.find(','), rest.size());
+        unsigned int day = 0;
+        ok = parse(rest.substr(0, end), day);
+        options.days.push_back(day);
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+      }
+    } else if (arg.starts_with("--arg=")) {
+      options.args.emplace_back(value);
+    } else if (arg.starts_with("--baseline-arg=")) {
+      options.baseline_args.emplace_back(value);
+    } else if (arg.starts_with("--")) {
+      ok = false;
+    } else {
+      positional.push_back(arg);
+    }
+    if (!ok) {
+      std::cerr << std::format("invalid option '{}'", arg) << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  // the embedded build takes the place of the baseline
+  if (positional.empty() || positional.size() > 2 ||
+      (options.embedded && (positional.size() == 2 || options.train))) {
+    return std::nullopt;
+  }
+  options.build = positional[0];
+  if (positional.size() == 2) {
+    options.baseline = positional[1];
+  }
+  return options;
+}
+
+// median wall time in ms, nullopt if the solver failed
+std::optional<double> time_solver(const fs::path &exe, const fs::path &cwd,
+                                  const std::vector<std::string> &args,
+                                  unsigned int runs) {
+  // one untimed run to warm the page cache
+  if (aoc::tools::run(exe, cwd, args).status != 0) {
+    return std::nullopt;
+  }
+  std::vector<double> times{};
+  for (auto i = 0U; i < runs; ++i) {
+    const auto result = aoc::tools::run(exe, cwd, args);
+    if (result.status != 0) {
+      return std::nullopt;
+    }
+    times.push_back(result.elapsed.count());
+  }
+  std::nth_element(times.begin(), times.begin() + times.size() / 2,
+                   times.end());
+  return times[times.size() / 2];
+}
+
+// configures and builds the solvers of `days` from this source tree with
+// their inputs taken from `inputs`/dayN/input; false if either step failed
+bool build_embedded(const fs::path &inputs, const fs::path &build,
+                    const std::vector<unsigned int> &days,
+                    const Options &options) {
+  using aoc::tools::quote;
+  auto configure = std::format(
+      "{} -S {} -B {} -DCMAKE_BUILD_TYPE=Release -DAOC_EMBED_INPUT_DIR={}",
+      quote(AOC_CMAKE_COMMAND), quote(AOC_SOURCE_DIR), quote(build.string()),
+      quote(inputs.string()));
+  for (const auto &k : options.cmake_args) {
+    configure += " " + quote(k);
+  }
+  configure += " > /dev/null";
+  if (std::system(configure.c_str()) != 0) {
+    return false;
+  }
+
+  auto compile = std::format("{} --build {} --parallel --target",
+                             quote(AOC_CMAKE_COMMAND), quote(build.string()));
+  for (const auto day : days) {
+    compile += std::format(" day{}_p1 day{}_p2", day, day);
+  }
+  compile += " > /dev/null";
+  return std::system(compile.c_str()) == 0;
+}
+
+std::string format_ms(const std::optional<double> &ms) {
+  return ms.has_value() ? std::format("{:.2f} ms", *ms) : "failed";
+}
+
+int main(int argc, char **argv) {
+  const auto options = parse_options(argc, argv);
+  if (!options.has_value()) {
+    std::cerr << "usage: " << argv[0]
+              << " [--train] [--days=1,2,...] [--runs=N] [--scale=N] "
+                 "[--seed=N] [--arg=X]... [--baseline-arg=X]... <build> "
+                 "[baseline-build]\n       "
+              << argv[0]
+              << " --embedded [--cmake-arg=X]... [--days=1,2,...] "
+                 "[--runs=N] [--scale=N] [--seed=N] [--arg=X]... <build>"
+              << std::endl;
+    return 2;
+  }
+
+  const aoc::tools::WorkDir work{"aoc-bench"};
+  auto failed = false;
+
+  // every input up front, the embedded build needs them before it compiles
+  std::vector<const aoc::gen::Generator *> selected{};
+  std::vector<unsigned int> days{};
+  for (const auto &generator : aoc::gen::generators) {
+    if (!options->days.empty() &&
+        std::find(options->days.begin(), options->days.end(),
+                  generator.day) == options->days.end()) {
+      continue;
+    }
+    const auto dir = work.path() / std::format("day{}", generator.day);
+    fs::create_directory(dir);
+    aoc::tools::write_input(dir / "input", generator,
+                            generator.training_size * options->scale,
+                            options->seed);
+    selected.push_back(&generator);
+    days.push_back(generator.day);
+  }
+
+  const auto embedded_build = work.path() / "embedded-build";
+  const auto empty_dir = work.path() / "embedded-run";
+  if (options->embedded) {
+    fs::create_directory(empty_dir);
+    if (!build_embedded(work.path(), embedded_build, days, *options)) {
+      std::cerr << "could not build the embedded-input solvers" << std::endl;
+      return 1;
+    }
+  }
+  const auto compared = options->baseline.has_value() || options->embedded;
+
+  if (!options->train) {
+    std::cout << std::format("{:>4} {:>4} {:>14} {:>14} {:>8}", "day", "part",
+                             options->embedded ? "runtime"
+                             : compared        ? "baseline"
+                                               : "",
+                             options->embedded ? "embedded" : "build",
+                             compared ? "speedup" : "")
+              << std::endl;
+  }
+
+  for (const auto *generator_ : selected) {
+    const auto &generator = *generator_;
+    const auto dir = work.path() / std::format("day{}", generator.day);
+
+    for (const auto part : {1U, 2U}) {
+      const auto exe =
+          aoc::tools::solver_path(options->build, generator.day, part);
+      if (!fs::exists(exe)) {
+        continue;
+      }
+
+      if (options->train) {
+        const auto result = aoc::tools::run(exe, dir, options->args);
+        std::cout << std::format("day{}_p{}: {}", generator.day, part,
+                                 format_ms(result.status == 0
+                                               ? std::optional(
+                                                     result.elapsed.count())
+                                               : std::nullopt))
+                  << std::endl;
+        // a crashing solver still leaves a usable partial profile, so
+        // training carries on and only reports it
+        continue;
+      }
+
+      if (options->embedded) {
+        const auto embedded_exe =
+            aoc::tools::solver_path(embedded_build, generator.day, part);
+        // only solvers that call aoc_embed_input() get the header directory
+        auto embed_dir = embedded_exe;
+        embed_dir += "_embed";
+        if (!fs::exists(embed_dir)) {
+          continue;
+        }
+        const auto runtime_time =
+            time_solver(exe, dir, options->args, options->runs);
+        const auto embedded_time = time_solver(embedded_exe, empty_dir,
+                                               options->args, options->runs);
+        const auto speedup =
+            runtime_time.has_value() && embedded_time.has_value()
+                ? std::format("{:.2f}x", *runtime_time / *embedded_time)
+                : std::string();
+        std::cout << std::format("{:>4} {:>4} {:>14} {:>14} {:>8}",
+                                 generator.day, part, format_ms(runtime_time),
+                                 format_ms(embedded_time), speedup)
+                  << std::endl;
+        failed |= !runtime_time.has_value() || !embedded_time.has_value();
+        continue;
+      }
+
+      const auto time = time_solver(exe, dir, options->args, options->runs);
+      std::optional<double> baseline_time{};
+      if (options->baseline.has_value()) {
+        const auto baseline_exe =
+            aoc::tools::solver_path(*options->baseline, generator.day, part);
+        if (fs::exists(baseline_exe)) {
+          baseline_time = time_solver(baseline_exe, dir,
+                                      options->baseline_args, options->runs);
+        }
+      }
+
+      const auto speedup = time.has_value() && baseline_time.has_value()
+                               ? std::format("{:.2f}x", *baseline_time / *time)
+                               : std::string();
+      std::cout << std::format("{:>4} {:>4} {:>14} {:>14} {:>8}",
+                               generator.day, part,
+                               options->baseline ? format_ms(baseline_time)
+                                                 : std::string(),
+                               format_ms(time), speedup)
+                << std::endl;
+      failed |= !time.has_value();
+    }
+  }
+
+  return failed ? 1 : 0;
+}
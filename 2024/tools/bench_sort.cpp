@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "aoc/input_gen.hpp"
+#include "aoc/parallel.hpp"
+#include "aoc/sort.hpp"
+
+// aoc_bench_sort [pairs] [seed]
+//
+// sorts two columns of day 1 sized location ids (5 digits) with std::sort
+// and with every aoc::sort method, sequential and parallel. the default is
+// 10^7 pairs, 10^8 needs about 2.4 GB.
+template <typename T> bool parse(std::string_view arg, T &value) {
+  const auto [ptr, ec] =
+      std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc() && ptr == arg.data() + arg.size();
+}
+
+int main(int argc, char **argv) {
+  std::size_t pairs = 10'000'000;
+  std::uint64_t seed = 2024;
+  if (argc > 3 || (argc > 1 && !parse(argv[1], pairs)) ||
+      (argc > 2 && !parse(argv[2], seed))) {
+    std::cerr << "usage: " << argv[0] << " [pairs] [seed]" << std::endl;
+    return 2;
+  }
+
+  aoc::gen::Rng rng{seed};
+  std::vector<int> l1(pairs);
+  std::vector<int> l2(pairs);
+  for (auto i = 0UL; i < pairs; ++i) {
+    l1[i] = aoc::gen::uniform(rng, 10000, 99999);
+    l2[i] = aoc::gen::uniform(rng, 10000, 99999);
+  }
+
+  auto expected1 = l1;
+  auto expected2 = l2;
+  std::sort(expected1.begin(), expected1.end());
+  std::sort(expected2.begin(), expected2.end());
+  std::vector<int> work1{};
+  std::vector<int> work2{};
+
+  const auto threads = aoc::par::hardware_threads();
+  std::vector<std::size_t> thread_counts{1};
+  if (threads > 1) {
+    thread_counts.push_back(threads);
+  }
+  const auto time = [&](std::string_view name, auto sort_column) {
+    work1 = l1;
+    work2 = l2;
+    const auto start = std::chrono::steady_clock::now();
+    sort_column(std::span<int>(work1));
+    sort_column(std::span<int>(work2));
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const auto ok = work1 == expected1 && work2 == expected2;
+    std::cout << std::format("{:<20} {:>10.1f} ms{}", name, elapsed.count(),
+                             ok ? "" : "  WRONG")
+              << std::endl;
+    return ok;
+  };
+
+  std::cout << std::format("{} pairs, {} threads, auto picks {}", pairs,
+                           threads,
+                           aoc::sort::to_string(aoc::sort::choose(
+                               pairs, aoc::sort::Bounds<int>{10000, 99999})))
+            << std::endl;
+
+  auto ok = time("std::sort", [](std::span<int> column) {
+    std::sort(column.begin(), column.end());
+  });
+
+  for (const auto method : {aoc::sort::Method::Counting,
+                            aoc::sort::Method::Radix}) {
+    for (const auto n : thread_counts) {
+      ok &= time(std::format("{} x{}", aoc::sort::to_string(method), n),
+                 [&](std::span<int> column) {
+                   aoc::sort::sort_with(method, column, n);
+                 });
+    }
+  }
+  ok &= time("auto", [](std::span<int> column) { aoc::sort::sort(column); });
+  ok &= time("auto parallel", [](std::span<int> column) {
+    aoc::sort::parallel_sort(column);
+  });
+
+  return ok ? 0 : 1;
+}
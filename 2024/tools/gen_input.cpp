@@ -0,0 +1,45 @@
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+#include "aoc/input_gen.hpp"
+
+// aoc_gen_input <day> [size] [seed] > input
+//
+// writes a random input for <day> to stdout, `size` defaults to the size the
+// PGO training run uses
+template <typename T> bool parse(std::string_view arg, T &value) {
+  const auto [ptr, ec] =
+      std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc() && ptr == arg.data() + arg.size();
+}
+
+int main(int argc, char **argv) {
+  unsigned int day = 0;
+  if (argc < 2 || argc > 4 || !parse(argv[1], day)) {
+    std::cerr << "usage: " << argv[0] << " <day> [size] [seed]" << std::endl;
+    return 2;
+  }
+
+  const auto *generator = aoc::gen::find(day);
+  if (generator == nullptr) {
+    std::cerr << std::format("no input generator for day {}", day)
+              << std::endl;
+    return 2;
+  }
+
+  auto size = generator->training_size;
+  std::uint64_t seed = 2024;
+  if ((argc > 2 && !parse(argv[2], size)) ||
+      (argc > 3 && !parse(argv[3], seed))) {
+    std::cerr << "size and seed must be unsigned integers" << std::endl;
+    return 2;
+  }
+
+  std::ios::sync_with_stdio(false);
+  aoc::gen::Rng rng{seed};
+  generator->generate(std::cout, rng, size);
+  return 0;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aoc/input_gen.hpp"
+
+// helpers shared by the tools that drive the day binaries of a build tree:
+// every solver reads ./input, so each run gets its own working directory
+namespace aoc::tools {
+
+namespace fs = std::filesystem;
+
+inline fs::path solver_path(const fs::path &build, unsigned int day,
+                            unsigned int part) {
+  return fs::absolute(build) / std::format("day{}", day) / "cpp" /
+         std::format("day{}_p{}", day, part);
+}
+
+// the frozen copy tools/verify compares dayN_pP against
+inline fs::path reference_path(const fs::path &build, unsigned int day,
+                               unsigned int part) {
+  auto path = solver_path(build, day, part);
+  path += "_reference";
+  return path;
+}
+
+// a fresh directory under the system temp dir, removed again on destruction
+class WorkDir {
+public:
+  explicit WorkDir(std::string_view name) {
+    const auto base = fs::temp_directory_path();
+    std::random_device seed{};
+    for (auto attempt = 0; attempt < 16; ++attempt) {
+      auto candidate = base / std::format("{}-{:08x}", name, seed());
+      if (fs::create_directory(candidate)) {
+        dir = std::move(candidate);
+        return;
+      }
+    }
+    throw std::runtime_error("could not create a work directory in " +
+                             base.string());
+  }
+  WorkDir(const WorkDir &) = delete;
+  WorkDir &operator=(const WorkDir &) = delete;
+  ~WorkDir() {
+    std::error_code ignored{};
+    fs::remove_all(dir, ignored);
+  }
+
+  const fs::path &path() const { return dir; }
+
+private:
+  fs::path dir{};
+};
+
+inline void write_input(const fs::path &file, const gen::Generator &generator,
+                        std::size_t size, std::uint64_t seed) {
+  std::ofstream out(file, std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error("could not write " + file.string());
+  }
+  gen::Rng rng{seed};
+  generator.generate(out, rng, size);
+}
+
+inline std::string generate_input(const gen::Generator &generator,
+                                  std::size_t size, std::uint64_t seed) {
+  std::ostringstream out{};
+  gen::Rng rng{seed};
+  generator.generate(out, rng, size);
+  return std::move(out).str();
+}
+
+inline void write_file(const fs::path &file, std::string_view content) {
+  std::ofstream out(file, std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error("could not write " + file.string());
+  }
+  out << content;
+}
+
+// solvers print their progress and end with the answer
+inline std::string last_line(const fs::path &file) {
+  std::ifstream in(file, std::ios::binary);
+  std::string line{};
+  std::string last{};
+  while (std::getline(in, line)) {
+    if (!line.empty()) {
+      last = line;
+    }
+  }
+  return last;
+}
+
+inline std::string quote(std::string_view arg) {
+  std::string quoted = "'";
+  for (const auto c : arg) {
+    quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+  }
+  return quoted + "'";
+}
+
+struct RunResult {
+  int status;
+  std::chrono::duration<double, std::milli> elapsed;
+};
+
+// runs `exe` inside `cwd` with stdout sent to `output` (or discarded)
+inline RunResult run(const fs::path &exe, const fs::path &cwd,
+                     const std::vector<std::string> &args,
+                     const fs::path &output = "/dev/null") {
+  auto command = "cd " + quote(cwd.string()) + " && " + quote(exe.string());
+  for (const auto &k : args) {
+    command += " " + quote(k);
+  }
+  command += " > " + quote(output.string()) + " 2> /dev/null";
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto status = std::system(command.c_str());
+  return {status, std::chrono::steady_clock::now() - start};
+}
+
+} // namespace aoc::tools
@@ -0,0 +1,463 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "aoc/abs_diff.hpp"
+#include "aoc/and_count.hpp"
+#include "aoc/cpu.hpp"
+#include "aoc/equal_mask.hpp"
+#include "aoc/input_gen.hpp"
+#include "day2/cpp/batch.hpp"
+#include "day3/cpp/prefilter.hpp"
+#include "run.hpp"
+
+// aoc_verify [--days=1,2,...] [--cases=N] [--seed=N] <build>
+//
+// differential check of every dayN_pP in <build> against its frozen
+// dayN_pP_reference: both run on random inputs growing from tiny up to the
+// generator's check_size, the optimised one once per ISA this machine
+// supports and once per extra mode it has (day 2's --fused). the first
+// mismatch per solver is shrunk to a minimal input, printed and kept in
+// <build>/verify-failures.
+//
+// before any of that the dispatched kernels the days share are checked in
+// process: every variant against the scalar one, on random lengths so the
+// tails past the last full vector get their share.
+namespace fs = std::filesystem;
+
+struct Options {
+  fs::path build{};
+  std::vector<unsigned int> days{};
+  unsigned int cases = 1000;
+  std::uint64_t seed = 2024;
+};
+
+template <typename T> bool parse(std::string_view arg, T &value) {
+  const auto [ptr, ec] =
+      std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc() && ptr == arg.data() + arg.size();
+}
+
+std::optional<Options> parse_options(int argc, char **argv) {
+  Options options{};
+  std::vector<std::string_view> positional{};
+  for (auto i = 1; i < argc; ++i) {
+    const auto arg = std::string_view(argv[i]);
+    const auto value = arg.substr(std::min(arg.find('=') + 1, arg.size()));
+    bool ok = true;
+    if (arg.starts_with("--cases=")) {
+      ok = parse(value, options.cases) && options.cases > 0;
+    } else if (arg.starts_with("--seed=")) {
+      ok = parse(value, options.seed);
+    } else if (arg.starts_with("--days=")) {
+      for (auto rest = value; ok && !rest.empty();) {
+        const auto end = std::min(rest.find(','), rest.size());
+        unsigned int day = 0;
+        ok = parse(rest.substr(0, end), day);
+        options.days.push_back(day);
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+      }
+    } else if (arg.starts_with("--")) {
+      ok = false;
+    } else {
+      positional.push_back(arg);
+    }
+    if (!ok) {
+      std::cerr << std::format("invalid option '{}'", arg) << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  if (positional.size() != 1) {
+    return std::nullopt;
+  }
+  options.build = positional[0];
+  return options;
+}
+
+struct Answer {
+  bool ok;
+  std::string line;
+};
+
+class Checker {
+public:
+  Checker(fs::path candidate_, fs::path reference_, fs::path dir_)
+      : candidate(std::move(candidate_)), reference(std::move(reference_)),
+        dir(std::move(dir_)) {}
+
+  Answer answer(const fs::path &exe, const std::string &input,
+                const std::vector<std::string> &args) const {
+    aoc::tools::write_file(dir / "input", input);
+    const auto output = dir / "output";
+    const auto result = aoc::tools::run(exe, dir, args, output);
+    return {result.status == 0, aoc::tools::last_line(output)};
+  }
+
+  // a counterexample needs a reference that copes with the input, anything
+  // the reference itself chokes on says nothing about the candidate
+  bool fails(const std::string &input,
+             const std::vector<std::string> &args) const {
+    const auto expected = answer(reference, input, {});
+    if (!expected.ok) {
+      return false;
+    }
+    const auto got = answer(candidate, input, args);
+    return !got.ok || got.line != expected.line;
+  }
+
+  const fs::path candidate;
+  const fs::path reference;
+
+private:
+  fs::path dir;
+};
+
+// delta debugging: drop ever smaller chunks as long as the input still fails
+template <typename Sequence, typename Fails>
+Sequence minimise(Sequence items, const Fails &fails) {
+  for (auto chunk = std::max<std::size_t>(items.size() / 2, 1); chunk > 0;
+       chunk /= 2) {
+    for (auto start = 0UL; start < items.size();) {
+      auto candidate = items;
+      candidate.erase(candidate.begin() + start,
+                      candidate.begin() +
+                          std::min(start + chunk, candidate.size()));
+      if (fails(candidate)) {
+        items = std::move(candidate);
+      } else {
+        start += chunk;
+      }
+    }
+  }
+  return items;
+}
+
+// whole lines first, then characters inside whatever lines are left
+std::string shrink(const std::string &input, const Checker &checker,
+                   const std::vector<std::string> &args) {
+  const auto join = [](const std::vector<std::string> &lines) {
+    std::string text{};
+    for (const auto &k : lines) {
+      text += k + '\n';
+    }
+    return text;
+  };
+
+  std::vector<std::string> lines{};
+  for (std::string_view rest = input; !rest.empty();) {
+    const auto end = std::min(rest.find('\n'), rest.size());
+    lines.emplace_back(rest.substr(0, end));
+    rest.remove_prefix(std::min(end + 1, rest.size()));
+  }
+
+  lines = minimise(std::move(lines), [&](const auto &candidate) {
+    return checker.fails(join(candidate), args);
+  });
+  for (auto i = 0UL; i < lines.size(); ++i) {
+    lines[i] = minimise(lines[i], [&](const std::string &candidate) {
+      auto attempt = lines;
+      attempt[i] = candidate;
+      return checker.fails(join(attempt), args);
+    });
+  }
+  return join(lines);
+}
+
+bool wanted(const Options &options, unsigned int day) {
+  return options.days.empty() || std::find(options.days.begin(),
+                                           options.days.end(),
+                                           day) != options.days.end();
+}
+
+// make(rng, length) builds an input, run(impl, input) its comparable result
+template <typename Fn, typename Make, typename Run>
+bool check_kernel(std::string_view name, const aoc::cpu::Kernel<Fn> &kernel,
+                  const Options &options, const Make &make, const Run &run) {
+  aoc::gen::Rng rng{options.seed};
+  auto isas = 0U;
+  kernel.for_each_variant([&](aoc::cpu::Isa, Fn *) { ++isas; });
+
+  for (auto i = 0U; i < options.cases; ++i) {
+    const auto length = aoc::gen::uniform<std::size_t>(rng, 0, 300);
+    const auto input = make(rng, length);
+    const auto expected = run(kernel.bind(aoc::cpu::Isa::Scalar), input);
+    std::optional<aoc::cpu::Isa> wrong{};
+    kernel.for_each_variant([&](aoc::cpu::Isa isa, Fn *impl) {
+      if (!wrong && run(impl, input) != expected) {
+        wrong = isa;
+      }
+    });
+    if (wrong) {
+      std::cout << std::format("{}: {} differs from scalar on case {} "
+                               "(length {})",
+                               name, aoc::cpu::to_string(*wrong), i, length)
+                << std::endl;
+      return false;
+    }
+  }
+  std::cout << std::format("{}: ok, {} inputs x {} isa", name, options.cases,
+                           isas)
+            << std::endl;
+  return true;
+}
+
+bool check_kernels(const Options &options) {
+  using aoc::gen::Rng;
+  using aoc::gen::uniform;
+  auto ok = true;
+
+  if (wanted(options, 1)) {
+    using Pair = std::pair<std::vector<int>, std::vector<int>>;
+    ok &= check_kernel(
+        "sum_abs_diff", aoc::kernels::sum_abs_diff_kernel, options,
+        [](Rng &rng, std::size_t length) {
+          // the whole range, so differences overflow an int
+          Pair columns{std::vector<int>(length), std::vector<int>(length)};
+          for (auto i = 0UL; i < length; ++i) {
+            columns.first[i] = uniform(rng, INT_MIN, INT_MAX);
+            columns.second[i] = uniform(rng, INT_MIN, INT_MAX);
+          }
+          return columns;
+        },
+        [](aoc::kernels::SumAbsDiffFn *impl, const Pair &columns) {
+          return impl(columns.first.data(), columns.second.data(),
+                      columns.first.size());
+        });
+  }
+
+  if (wanted(options, 2)) {
+    // `length` reports, padded to whole lanes the way Batch does
+    struct Columns {
+      std::size_t padded;
+      std::vector<int> levels;
+    };
+    ok &= check_kernel(
+        "batch_safe", report::batch_safe_kernel, options,
+        [](Rng &rng, std::size_t length) {
+          const auto lanes = report::Batch::lanes;
+          const auto padded = (length + lanes - 1) / lanes * lanes;
+          Columns columns{padded, std::vector<int>(report::max_levels * padded,
+                                                   report::sentinel)};
+          for (auto r = 0UL; r < length; ++r) {
+            const auto count = uniform<std::size_t>(rng, 1, report::max_levels);
+            auto level = uniform(rng, -100, 100);
+            for (auto j = 0UL; j < count; ++j) {
+              // steps of -4..4 sit on both sides of every bound
+              level += uniform(rng, -4, 4);
+              columns.levels[j * padded + r] = level;
+            }
+          }
+          return columns;
+        },
+        [](report::BatchFn *impl, const Columns &columns) {
+          std::vector<std::uint8_t> safe(columns.padded);
+          impl(columns.levels.data(), columns.padded, columns.padded,
+               safe.data());
+          return safe;
+        });
+  }
+
+  if (wanted(options, 3)) {
+    ok &= check_kernel(
+        "find_candidate", instructions::find_candidate_kernel, options,
+        [](Rng &rng, std::size_t length) {
+          constexpr auto alphabet = std::string_view("mul(do()n't,)1x");
+          std::string text(length, ' ');
+          for (auto &c : text) {
+            c = aoc::gen::pick(rng, alphabet);
+          }
+          return text;
+        },
+        [](instructions::FindFn *impl, const std::string &text) {
+          // every offset the kernel stops at, not just the first
+          std::vector<std::size_t> stops{};
+          for (auto at = 0UL; at < text.size(); ++at) {
+            at += impl(text.data() + at, text.size() - at);
+            stops.push_back(at);
+          }
+          return stops;
+        });
+  }
+
+  if (wanted(options, 4)) {
+    constexpr auto values = std::string_view("XMAS");
+    ok &= check_kernel(
+        "equal_masks", aoc::kernels::equal_masks_kernel, options,
+        [](Rng &rng, std::size_t length) {
+          std::string cells(length, ' ');
+          for (auto &c : cells) {
+            c = aoc::gen::pick(rng, std::string_view("XMAS."));
+          }
+          return cells;
+        },
+        [&](aoc::kernels::EqualMasksFn *impl, const std::string &cells) {
+          // garbage first, every word has to be overwritten
+          std::vector<std::vector<std::uint64_t>> planes(
+              values.size(),
+              std::vector<std::uint64_t>((cells.size() + 63) / 64,
+                                         0x5555555555555555));
+          std::vector<std::uint64_t *> out{};
+          for (auto &k : planes) {
+            out.push_back(k.data());
+          }
+          impl(cells.data(), cells.size(), values.data(), values.size(),
+               out.data());
+          return planes;
+        });
+
+    // `length` words of every row, at random shifts and from a random first
+    struct Rows {
+      std::vector<std::vector<std::uint64_t>> words;
+      std::vector<unsigned> shifts;
+      std::size_t first;
+    };
+    ok &= check_kernel(
+        "and_count", aoc::kernels::and_count_kernel, options,
+        [](Rng &rng, std::size_t length) {
+          Rows rows{{}, {}, uniform<std::size_t>(rng, 0, length)};
+          for (auto k = uniform(rng, 1, 5); k > 0; --k) {
+            auto &words = rows.words.emplace_back(length + 1);
+            for (auto &w : words) {
+              // dense enough that the AND of a few rows keeps some bits
+              w = rng() | rng();
+            }
+            rows.shifts.push_back(uniform(rng, 0U, 63U));
+          }
+          return rows;
+        },
+        [](aoc::kernels::AndCountFn *impl, const Rows &rows) {
+          std::vector<const std::uint64_t *> pointers{};
+          for (const auto &k : rows.words) {
+            pointers.push_back(k.data());
+          }
+          return impl(pointers.data(), rows.shifts.data(), pointers.size(),
+                      rows.first, rows.words[0].size() - 1);
+        });
+  }
+  return ok;
+}
+
+// other ways a solver can get to its answer, checked like the isa variants
+struct Mode {
+  unsigned int day;
+  std::string_view flag;
+};
+
+inline constexpr auto modes = std::array{
+    // parse and check fused, on every core
+    Mode{2, "--fused"},
+};
+
+int main(int argc, char **argv) {
+  const auto options = parse_options(argc, argv);
+  if (!options.has_value()) {
+    std::cerr << "usage: " << argv[0]
+              << " [--days=1,2,...] [--cases=N] [--seed=N] <build>"
+              << std::endl;
+    return 2;
+  }
+
+  // every kernel path the candidate can take on this machine
+  std::vector<std::vector<std::string>> variants{};
+  for (auto i = 0U; i < aoc::cpu::isa_count; ++i) {
+    const auto isa = static_cast<aoc::cpu::Isa>(i);
+    if (aoc::cpu::supports(isa)) {
+      variants.push_back(
+          {std::format("--force-isa={}", aoc::cpu::to_string(isa))});
+    }
+  }
+
+  const aoc::tools::WorkDir work{"aoc-verify"};
+  const auto failures = options->build / "verify-failures";
+  auto failed = !check_kernels(*options);
+
+  for (const auto &generator : aoc::gen::generators) {
+    if (!wanted(*options, generator.day)) {
+      continue;
+    }
+
+    for (const auto part : {1U, 2U}) {
+      const Checker checker{
+          aoc::tools::solver_path(options->build, generator.day, part),
+          aoc::tools::reference_path(options->build, generator.day, part),
+          work.path()};
+      if (!fs::exists(checker.candidate) || !fs::exists(checker.reference)) {
+        continue;
+      }
+
+      auto runs = variants;
+      for (const auto &mode : modes) {
+        if (mode.day == generator.day) {
+          runs.push_back({std::string(mode.flag)});
+        }
+      }
+
+      const auto name = std::format("day{}_p{}", generator.day, part);
+      auto checked = 0U;
+      auto skipped = 0U;
+      std::optional<std::string> counterexample{};
+      for (auto i = 0U; i < options->cases && !counterexample; ++i) {
+        const auto size = 1 + i * generator.check_size / options->cases;
+        const auto input = aoc::tools::generate_input(generator, size,
+                                                      options->seed + i);
+        const auto expected = checker.answer(checker.reference, input, {});
+        if (!expected.ok) {
+          ++skipped;
+          continue;
+        }
+        ++checked;
+
+        for (const auto &args : runs) {
+          const auto got = checker.answer(checker.candidate, input, args);
+          if (got.ok && got.line == expected.line) {
+            continue;
+          }
+          std::cout << std::format("{}: mismatch with {} on case {}, "
+                                   "shrinking...",
+                                   name, args[0], i)
+                    << std::endl;
+          counterexample = shrink(input, checker, args);
+
+          const auto minimal_expected =
+              checker.answer(checker.reference, *counterexample, {});
+          const auto minimal_got =
+              checker.answer(checker.candidate, *counterexample, args);
+          fs::create_directories(failures);
+          const auto file = failures / (name + ".input");
+          aoc::tools::write_file(file, *counterexample);
+          std::cout << std::format("{}: minimal input ({} bytes, saved to "
+                                   "{}):\n{}expected: {}\n     got: {}",
+                                   name, counterexample->size(),
+                                   file.string(), *counterexample,
+                                   minimal_expected.line,
+                                   minimal_got.ok ? minimal_got.line
+                                                  : "failed")
+                    << std::endl;
+          break;
+        }
+      }
+
+      if (counterexample) {
+        failed = true;
+      } else {
+        std::cout << std::format("{}: ok, {} inputs x {} isa + {} modes ({} "
+                                 "the reference rejected)",
+                                 name, checked, variants.size(),
+                                 runs.size() - variants.size(), skipped)
+                  << std::endl;
+      }
+    }
+  }
+
+  return failed ? 1 : 0;
+}